@@ -42,7 +42,7 @@ void CommonAbstractObjectSetToVtkPartitionedDataSetSet::loadVtkObject()
 {
 	for (uint32_t w_i = _procNumber; w_i < _mapperSet.size(); w_i += _maxProc)
 	{
-		_mapperSet[w_i]->loadVtkObject();
+		_mapperSet[w_i]->loadVtkObjectWithStatistics();
 	}
 }
 
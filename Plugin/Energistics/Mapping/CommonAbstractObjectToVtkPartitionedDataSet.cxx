@@ -18,6 +18,89 @@ under the License.
 -----------------------------------------------------------------------*/
 #include "CommonAbstractObjectToVtkPartitionedDataSet.h"
 
+#include <algorithm>
+
+// include VTK library
+#include <vtkDataObject.h>
+#include <vtkDoubleArray.h>
+#include <vtkFieldData.h>
+#include <vtkFloatArray.h>
+
+namespace
+{
+	std::mutex s_fesapiMutex;
+	thread_local CommonAbstractObjectToVtkPartitionedDataSet::FesapiLock *t_fesapiLock = nullptr;
+	// ms the current thread has waited for the fesapi lock at the end of its FesapiUnlock scopes
+	thread_local double t_fesapiLockWaitTime = 0;
+
+	// only modify the field data (and the MTime of the dataset) when the value changes
+	void setFieldValue(vtkFieldData *p_fieldData, const char *p_name, double p_value)
+	{
+		vtkDoubleArray *w_array = vtkDoubleArray::SafeDownCast(p_fieldData->GetAbstractArray(p_name));
+		if (w_array == nullptr)
+		{
+			vtkSmartPointer<vtkDoubleArray> w_newArray = vtkSmartPointer<vtkDoubleArray>::New();
+			w_newArray->SetName(p_name);
+			w_newArray->SetNumberOfValues(1);
+			w_newArray->SetValue(0, p_value);
+			p_fieldData->AddArray(w_newArray);
+		}
+		else if (w_array->GetValue(0) != p_value)
+		{
+			w_array->SetValue(0, p_value);
+			w_array->Modified();
+		}
+	}
+}
+
+//----------------------------------------------------------------------------
+CommonAbstractObjectToVtkPartitionedDataSet::FesapiLock::FesapiLock() :
+	_lock(s_fesapiMutex),
+	_previous(t_fesapiLock)
+{
+	t_fesapiLock = this;
+}
+
+//----------------------------------------------------------------------------
+CommonAbstractObjectToVtkPartitionedDataSet::FesapiLock::~FesapiLock()
+{
+	t_fesapiLock = _previous;
+}
+
+//----------------------------------------------------------------------------
+CommonAbstractObjectToVtkPartitionedDataSet::FesapiUnlock::FesapiUnlock() :
+	_fesapiLock(t_fesapiLock)
+{
+	if (_fesapiLock != nullptr)
+	{
+		_fesapiLock->_lock.unlock();
+	}
+}
+
+//----------------------------------------------------------------------------
+CommonAbstractObjectToVtkPartitionedDataSet::FesapiUnlock::~FesapiUnlock()
+{
+	if (_fesapiLock != nullptr)
+	{
+		const auto start = std::chrono::high_resolution_clock::now();
+		_fesapiLock->_lock.lock();
+		t_fesapiLockWaitTime += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+}
+
+//----------------------------------------------------------------------------
+CommonAbstractObjectToVtkPartitionedDataSet::ScopedTimer::ScopedTimer(double &p_duration) :
+	_duration(p_duration),
+	_start(std::chrono::high_resolution_clock::now())
+{
+}
+
+//----------------------------------------------------------------------------
+CommonAbstractObjectToVtkPartitionedDataSet::ScopedTimer::~ScopedTimer()
+{
+	_duration += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - _start).count();
+}
+
 //----------------------------------------------------------------------------
 CommonAbstractObjectToVtkPartitionedDataSet::CommonAbstractObjectToVtkPartitionedDataSet(const COMMON_NS::AbstractObject* p_abstractObject, uint32_t p_procNumber, uint32_t p_maxProc):
 	_procNumber(p_procNumber),
@@ -28,3 +111,126 @@ CommonAbstractObjectToVtkPartitionedDataSet::CommonAbstractObjectToVtkPartitione
 	_resqmlData(p_abstractObject)
 {
 }
+
+//----------------------------------------------------------------------------
+void CommonAbstractObjectToVtkPartitionedDataSet::loadVtkObjectWithStatistics()
+{
+	_temporaryBytes = 0;
+	// the time spent waiting for another thread to release the fesapi lock is not a loading time
+	const double lockWaitTime = t_fesapiLockWaitTime;
+	{
+		ScopedTimer w_timer(_loadingStatistics.loadTime);
+		loadVtkObject();
+	}
+	_loadingStatistics.loadTime -= t_fesapiLockWaitTime - lockWaitTime;
+	recordPeakMemory();
+}
+
+//----------------------------------------------------------------------------
+void CommonAbstractObjectToVtkPartitionedDataSet::recordReading(uint64_t p_valueCount, uint64_t p_valueSize, uint64_t p_temporaryBytes)
+{
+	_loadingStatistics.bytesRead += p_valueCount * p_valueSize;
+	_loadingStatistics.valuesConverted += p_valueCount;
+	_temporaryBytes = (std::max)(_temporaryBytes, p_temporaryBytes);
+}
+
+//----------------------------------------------------------------------------
+void CommonAbstractObjectToVtkPartitionedDataSet::recordPeakMemory()
+{
+	const uint64_t w_outputBytes = _vtkData == nullptr ? 0 : static_cast<uint64_t>(_vtkData->GetActualMemorySize()) * 1024;
+	_loadingStatistics.peakBytes = (std::max)(_loadingStatistics.peakBytes, w_outputBytes + _temporaryBytes);
+	_temporaryBytes = 0;
+}
+
+//----------------------------------------------------------------------------
+void CommonAbstractObjectToVtkPartitionedDataSet::initLocalOrigin(const double *p_xyzPoints, vtkIdType p_pointCount)
+{
+	if (!_singlePrecision || _hasLocalOrigin || p_pointCount <= 0)
+	{
+		return;
+	}
+
+	// the center of the bounds halves the largest relative coordinate
+	std::array<double, 3> w_min = {{p_xyzPoints[0], p_xyzPoints[1], p_xyzPoints[2]}};
+	std::array<double, 3> w_max = w_min;
+	for (vtkIdType w_pointIndex = 1; w_pointIndex < p_pointCount; ++w_pointIndex)
+	{
+		for (int w_component = 0; w_component < 3; ++w_component)
+		{
+			const double w_value = p_xyzPoints[w_pointIndex * 3 + w_component];
+			w_min[w_component] = (std::min)(w_min[w_component], w_value);
+			w_max[w_component] = (std::max)(w_max[w_component], w_value);
+		}
+	}
+	for (int w_component = 0; w_component < 3; ++w_component)
+	{
+		_localOrigin[w_component] = (w_min[w_component] + w_max[w_component]) / 2;
+	}
+	_hasLocalOrigin = true;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> CommonAbstractObjectToVtkPartitionedDataSet::createPointsData(vtkDoubleArray *p_xyzPoints)
+{
+	if (!_singlePrecision)
+	{
+		return p_xyzPoints;
+	}
+
+	const vtkIdType w_pointCount = p_xyzPoints->GetNumberOfTuples();
+	initLocalOrigin(p_xyzPoints->GetPointer(0), w_pointCount);
+
+	vtkSmartPointer<vtkFloatArray> w_floatPoints = vtkSmartPointer<vtkFloatArray>::New();
+	w_floatPoints->SetNumberOfComponents(3);
+	w_floatPoints->SetNumberOfTuples(w_pointCount);
+	const double *w_xyzPoints = p_xyzPoints->GetPointer(0);
+	float *w_floatXyzPoints = w_floatPoints->GetPointer(0);
+	for (vtkIdType w_pointIndex = 0; w_pointIndex < w_pointCount; ++w_pointIndex)
+	{
+		w_floatXyzPoints[w_pointIndex * 3] = static_cast<float>(w_xyzPoints[w_pointIndex * 3] - _localOrigin[0]);
+		w_floatXyzPoints[w_pointIndex * 3 + 1] = static_cast<float>(w_xyzPoints[w_pointIndex * 3 + 1] - _localOrigin[1]);
+		w_floatXyzPoints[w_pointIndex * 3 + 2] = static_cast<float>(w_xyzPoints[w_pointIndex * 3 + 2] - _localOrigin[2]);
+	}
+	// the double points only live during the conversion
+	_temporaryBytes = (std::max)(_temporaryBytes, static_cast<uint64_t>(w_pointCount) * 3 * sizeof(double));
+	return w_floatPoints;
+}
+
+//----------------------------------------------------------------------------
+void CommonAbstractObjectToVtkPartitionedDataSet::addLocalOrigin(vtkDataObject *p_dataSet) const
+{
+	if (!_hasLocalOrigin || p_dataSet == nullptr)
+	{
+		return;
+	}
+	vtkSmartPointer<vtkDoubleArray> w_origin = vtkSmartPointer<vtkDoubleArray>::New();
+	w_origin->SetName("LocalOrigin");
+	w_origin->SetNumberOfComponents(3);
+	w_origin->SetNumberOfTuples(1);
+	w_origin->SetTypedTuple(0, _localOrigin.data());
+	p_dataSet->GetFieldData()->AddArray(w_origin);
+}
+
+//----------------------------------------------------------------------------
+void CommonAbstractObjectToVtkPartitionedDataSet::addLoadingStatisticsToOutput() const
+{
+	if (_vtkData == nullptr)
+	{
+		return;
+	}
+	for (unsigned int w_partitionIndex = 0; w_partitionIndex < _vtkData->GetNumberOfPartitions(); ++w_partitionIndex)
+	{
+		vtkDataObject *w_partition = _vtkData->GetPartitionAsDataObject(w_partitionIndex);
+		if (w_partition == nullptr)
+		{
+			continue;
+		}
+		vtkFieldData *w_fieldData = w_partition->GetFieldData();
+		setFieldValue(w_fieldData, "LoadTime(ms)", _loadingStatistics.loadTime);
+		setFieldValue(w_fieldData, "PointsTime(ms)", _loadingStatistics.pointsTime);
+		setFieldValue(w_fieldData, "PropertiesTime(ms)", _loadingStatistics.propertiesTime);
+		setFieldValue(w_fieldData, "BytesRead", static_cast<double>(_loadingStatistics.bytesRead));
+		setFieldValue(w_fieldData, "ValuesConverted", static_cast<double>(_loadingStatistics.valuesConverted));
+		setFieldValue(w_fieldData, "PeakBytes", static_cast<double>(_loadingStatistics.peakBytes));
+	}
+}
@@ -20,12 +20,18 @@ under the License.
 #define __CommonAbstractObjectTovtkPartitionedDataSet__h__
 
 // include system
+#include <array>
+#include <chrono>
+#include <mutex>
 #include <string>
 
 // include VTK library
 #include <vtkSmartPointer.h>
 #include <vtkPartitionedDataSet.h>
 
+class vtkDataArray;
+class vtkDoubleArray;
+
 // include F2i-consulting Energistics Standards API
 #include <fesapi/common/AbstractObject.h>
 
@@ -34,6 +40,52 @@ under the License.
 class CommonAbstractObjectToVtkPartitionedDataSet
 {
 public:
+	class FesapiUnlock;
+
+	/**
+	 * fesapi and HDF5 are not thread safe: when the mappers are loaded in parallel,
+	 * loadVtkObject is called while the loading thread holds a FesapiLock.
+	 */
+	class FesapiLock
+	{
+	public:
+		FesapiLock();
+		~FesapiLock();
+
+	private:
+		friend class FesapiUnlock;
+
+		std::unique_lock<std::mutex> _lock;
+		FesapiLock *_previous;
+	};
+
+	/**
+	 * Release the FesapiLock of the current thread (if any) during its lifetime.
+	 * Only use it around code which builds VTK objects from data already read by fesapi.
+	 */
+	class FesapiUnlock
+	{
+	public:
+		FesapiUnlock();
+		~FesapiUnlock();
+
+	private:
+		FesapiLock *_fesapiLock;
+	};
+
+	/**
+	 * statistics of the loadings of the object and of its properties (accumulated since its creation)
+	 */
+	struct LoadingStatistics
+	{
+		double loadTime = 0;		  // ms spent in loadVtkObject, without waiting for the fesapi lock
+		double pointsTime = 0;		  // ms spent in createPoints (included in loadTime)
+		double propertiesTime = 0;	  // ms spent in addDataArray
+		uint64_t bytesRead = 0;		  // bytes of the points and of the property values read through fesapi
+		uint64_t valuesConverted = 0; // values copied into VTK arrays
+		uint64_t peakBytes = 0;		  // largest memory used by the output and a temporary buffer of one loading
+	};
+
 	/**
 	 * Constructor
 	 */
@@ -50,6 +102,30 @@ public:
 	 */
 	virtual void loadVtkObject() = 0;
 
+	/**
+	 * call loadVtkObject and record its duration and memory in the loading statistics
+	 */
+	void loadVtkObjectWithStatistics();
+
+	const LoadingStatistics &getLoadingStatistics() const { return _loadingStatistics; }
+
+	/**
+	 * set the loading statistics as field data of each partition of the output
+	 */
+	void addLoadingStatisticsToOutput() const;
+
+	/**
+	 * store the geometry (and the continuous properties) in single precision: the points are relative to a local origin of the object.
+	 * Only taken into account by the next loading.
+	 */
+	void setSinglePrecision(bool p_singlePrecision) { _singlePrecision = p_singlePrecision; }
+
+	/**
+	 * set the local origin of the points (if any) as the "LocalOrigin" field data of p_dataSet:
+	 * the absolute coordinates are the points plus this origin.
+	 */
+	void addLocalOrigin(vtkDataObject *p_dataSet) const;
+
 	/**
 	 * @return the vtkPartitionedDataSet of RESQML object
 	 */
@@ -63,6 +139,43 @@ public:
 protected:
 	const COMMON_NS::AbstractObject* getResqmlData() const { return _resqmlData; }
 
+	/**
+	 * add the wall time of its scope to a duration (in ms) of the loading statistics
+	 */
+	class ScopedTimer
+	{
+	public:
+		explicit ScopedTimer(double &p_duration);
+		~ScopedTimer();
+
+	private:
+		double &_duration;
+		std::chrono::high_resolution_clock::time_point _start;
+	};
+
+	/**
+	 * record the reading of p_valueCount values of p_valueSize bytes which are copied into VTK arrays
+	 * @param p_temporaryBytes	size of the temporary buffer used for this reading (not kept by VTK)
+	 */
+	void recordReading(uint64_t p_valueCount, uint64_t p_valueSize, uint64_t p_temporaryBytes = 0);
+	/**
+	 * update the peak memory once a loading is over
+	 */
+	void recordPeakMemory();
+
+	/**
+	 * in single precision, set the local origin of the object at the center of the bounds of p_pointCount points
+	 * if it is not set yet: the pieces of a partitioned object must give the points of the whole object (or the same subset)
+	 * to share the same origin
+	 */
+	void initLocalOrigin(const double *p_xyzPoints, vtkIdType p_pointCount);
+
+	/**
+	 * @return the array of points to give to vtkPoints::SetData: p_xyzPoints itself or, in single precision,
+	 * its float copy relative to the local origin of the object (see initLocalOrigin, else the center of the bounds of p_xyzPoints)
+	 */
+	vtkSmartPointer<vtkDataArray> createPointsData(vtkDoubleArray *p_xyzPoints);
+
 	uint32_t _procNumber;
 	uint32_t _maxProc;
 
@@ -71,6 +184,13 @@ protected:
 	std::string _absUuid;
 	std::string _absTitle;
 
+	LoadingStatistics _loadingStatistics;
+	uint64_t _temporaryBytes = 0; // largest temporary buffer of the current loading
+
+	bool _singlePrecision = false;
+	bool _hasLocalOrigin = false;
+	std::array<double, 3> _localOrigin = {{0, 0, 0}};
+
 private:
 	const COMMON_NS::AbstractObject* _resqmlData;
 };
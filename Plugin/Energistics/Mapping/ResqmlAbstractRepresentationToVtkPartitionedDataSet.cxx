@@ -45,46 +45,146 @@ ResqmlAbstractRepresentationToVtkPartitionedDataSet::ResqmlAbstractRepresentatio
 }
 
 void ResqmlAbstractRepresentationToVtkPartitionedDataSet::addDataArray(const std::string &p_uuid, uint32_t p_patchIndex)
+{
+	ScopedTimer w_timer(_loadingStatistics.propertiesTime);
+	addDataArray(p_uuid, createDataArray(p_uuid, p_patchIndex));
+}
+
+RESQML2_NS::AbstractValuesProperty const *ResqmlAbstractRepresentationToVtkPartitionedDataSet::getValuesProperty(const std::string &p_uuid) const
 {
 	std::vector<RESQML2_NS::AbstractValuesProperty *> w_valuesPropertySet = getResqmlData()->getValuesPropertySet();
 	std::vector<RESQML2_NS::AbstractValuesProperty *>::iterator w_it = std::find_if(w_valuesPropertySet.begin(), w_valuesPropertySet.end(),
 																					[&p_uuid](RESQML2_NS::AbstractValuesProperty const *w_property)
 																					{ return w_property->getUuid() == p_uuid; });
-	if (w_it != std::end(w_valuesPropertySet))
+	if (w_it == std::end(w_valuesPropertySet))
+	{
+		throw std::invalid_argument("The property " + p_uuid + "cannot be added since it is not contained in the representation " + getResqmlData()->getUuid());
+	}
+	return *w_it;
+}
+
+ResqmlPropertyToVtkDataArray *ResqmlAbstractRepresentationToVtkPartitionedDataSet::createDataArray(const std::string &p_uuid, uint32_t p_patchIndex) const
+{
+	auto const *const w_resqmlProp = getValuesProperty(p_uuid);
+	if (_stride > 1)
 	{
-		auto const *const w_resqmlProp = *w_it;
-		ResqmlPropertyToVtkDataArray *w_fesppProperty = _isHyperslabed
-														  ? new ResqmlPropertyToVtkDataArray(w_resqmlProp,
-																							 _iCellCount * _jCellCount * (_maxKIndex - _initKIndex),
-																							 _pointCount,
-																							 _iCellCount,
-																							 _jCellCount,
-																							 _maxKIndex - _initKIndex,
-																							 _initKIndex,
-																							 p_patchIndex)
-														  : new ResqmlPropertyToVtkDataArray(w_resqmlProp,
-																							 _iCellCount * _jCellCount * _kCellCount,
-																							 _pointCount,
-																							 p_patchIndex);
-		switch (w_resqmlProp->getAttachmentKind())
+		// coarsened preview: the value of the first fine cell of each coarse cell
+		if (w_resqmlProp->getAttachmentKind() != gsoap_eml2_3::eml23__IndexableElement::cells)
 		{
-		case gsoap_eml2_3::eml23__IndexableElement::cells:
-		case gsoap_eml2_3::eml23__IndexableElement::triangles:
-			_vtkData->GetPartition(0)->GetCellData()->AddArray(w_fesppProperty->getVtkData());
-			break;
-		case gsoap_eml2_3::eml23__IndexableElement::nodes:
-			_vtkData->GetPartition(0)->GetPointData()->AddArray(w_fesppProperty->getVtkData());
-			break;
-		default:
-			throw std::invalid_argument("The property " + p_uuid + " is attached on a non supported topological element i.e. not cell, not point.");
+			throw std::invalid_argument("The property " + p_uuid + " cannot be loaded on a coarsened grid since it is not attached to cells.");
 		}
-		_uuidToVtkDataArray[p_uuid] = w_fesppProperty;
-		_vtkData->Modified();
+		const uint32_t w_iCoarseCount = getCoarseIndex(_maxIIndex) - getCoarseIndex(_initIIndex);
+		const uint32_t w_jCoarseCount = getCoarseIndex(_maxJIndex) - getCoarseIndex(_initJIndex);
+		const uint32_t w_kCoarseCount = getCoarseIndex(_maxKIndex) - getCoarseIndex(_initKIndex);
+		return new ResqmlPropertyToVtkDataArray(w_resqmlProp,
+												static_cast<uint64_t>(w_iCoarseCount) * w_jCoarseCount * w_kCoarseCount,
+												_pointCount,
+												w_iCoarseCount,
+												w_jCoarseCount,
+												w_kCoarseCount,
+												getCoarseIndex(_initIIndex) * _stride,
+												getCoarseIndex(_initJIndex) * _stride,
+												getCoarseIndex(_initKIndex) * _stride,
+												_iCellCount,
+												_jCellCount,
+												p_patchIndex,
+												_stride);
 	}
-	else
+	return _isHyperslabed
+			   ? new ResqmlPropertyToVtkDataArray(w_resqmlProp,
+												  static_cast<uint64_t>(_maxIIndex - _initIIndex) * (_maxJIndex - _initJIndex) * (_maxKIndex - _initKIndex),
+												  _pointCount,
+												  _maxIIndex - _initIIndex,
+												  _maxJIndex - _initJIndex,
+												  _maxKIndex - _initKIndex,
+												  _initIIndex,
+												  _initJIndex,
+												  _initKIndex,
+												  _iCellCount,
+												  _jCellCount,
+												  p_patchIndex)
+			   : new ResqmlPropertyToVtkDataArray(w_resqmlProp,
+												  _iCellCount * _jCellCount * _kCellCount,
+												  _pointCount,
+												  p_patchIndex,
+												  _singlePrecision);
+}
+
+void ResqmlAbstractRepresentationToVtkPartitionedDataSet::addDataArray(const std::string &p_uuid, ResqmlPropertyToVtkDataArray *p_dataArray)
+{
+	switch (getValuesProperty(p_uuid)->getAttachmentKind())
 	{
-		throw std::invalid_argument("The property " + p_uuid + "cannot be added since it is not contained in the representation " + getResqmlData()->getUuid());
+	case gsoap_eml2_3::eml23__IndexableElement::cells:
+	case gsoap_eml2_3::eml23__IndexableElement::triangles:
+		_vtkData->GetPartition(0)->GetCellData()->AddArray(mapCellValues(p_dataArray->getVtkData()));
+		break;
+	case gsoap_eml2_3::eml23__IndexableElement::nodes:
+		_vtkData->GetPartition(0)->GetPointData()->AddArray(p_dataArray->getVtkData());
+		break;
+	default:
+		delete p_dataArray;
+		throw std::invalid_argument("The property " + p_uuid + " is attached on a non supported topological element i.e. not cell, not point.");
 	}
+	_uuidToVtkDataArray[p_uuid] = p_dataArray;
+	_vtkData->Modified();
+
+	recordReading(p_dataArray->getVtkData()->GetNumberOfValues(), p_dataArray->getVtkData()->GetDataTypeSize());
+	recordPeakMemory();
+}
+
+bool ResqmlAbstractRepresentationToVtkPartitionedDataSet::replaceDataArray(const std::string &p_oldUuid, const std::string &p_newUuid, ResqmlPropertyToVtkDataArray *p_newDataArray)
+{
+	ScopedTimer w_timer(_loadingStatistics.propertiesTime);
+	auto w_it = _uuidToVtkDataArray.find(p_oldUuid);
+	if (w_it == _uuidToVtkDataArray.end() || w_it->second == nullptr ||
+		getValuesProperty(p_oldUuid)->getAttachmentKind() != getValuesProperty(p_newUuid)->getAttachmentKind())
+	{
+		return false;
+	}
+
+	ResqmlPropertyToVtkDataArray *w_vtkDataArray = w_it->second;
+	const bool w_onNodes = getValuesProperty(p_newUuid)->getAttachmentKind() == gsoap_eml2_3::eml23__IndexableElement::nodes;
+	vtkDataSetAttributes *const w_attributes = w_onNodes
+												   ? static_cast<vtkDataSetAttributes *>(_vtkData->GetPartition(0)->GetPointData())
+												   : static_cast<vtkDataSetAttributes *>(_vtkData->GetPartition(0)->GetCellData());
+	// the new values take the place (index and name) of the old ones in the dataset so that the array indices do not change
+	const std::string w_name = w_vtkDataArray->getVtkData()->GetName();
+	int w_arrayIndex = -1;
+	if (w_attributes->GetAbstractArray(w_name.c_str(), w_arrayIndex) == nullptr)
+	{
+		return false;
+	}
+
+	if (p_newDataArray != nullptr)
+	{
+		// an array already read (e.g. in background) is adopted as is
+		vtkDataArray *const w_oldValues = w_vtkDataArray->getVtkData();
+		vtkDataArray *const w_newValues = p_newDataArray->getVtkData();
+		if (w_newValues == nullptr ||
+			w_newValues->GetDataType() != w_oldValues->GetDataType() ||
+			w_newValues->GetNumberOfComponents() != w_oldValues->GetNumberOfComponents() ||
+			w_newValues->GetNumberOfValues() != w_oldValues->GetNumberOfValues())
+		{
+			return false;
+		}
+		w_newValues->SetName(w_name.c_str());
+		delete w_vtkDataArray;
+		w_vtkDataArray = p_newDataArray;
+	}
+	// the buffer of the array is reused only if the mapper is its sole owner,
+	// otherwise (e.g. an output already handed to the pipeline) the values are read into a new array
+	else if (!w_vtkDataArray->replaceValues(getValuesProperty(p_newUuid)))
+	{
+		return false;
+	}
+	w_attributes->SetArray(w_arrayIndex, w_onNodes ? w_vtkDataArray->getVtkData() : mapCellValues(w_vtkDataArray->getVtkData()));
+	_vtkData->Modified();
+
+	_uuidToVtkDataArray.erase(w_it);
+	_uuidToVtkDataArray[p_newUuid] = w_vtkDataArray;
+
+	recordReading(w_vtkDataArray->getVtkData()->GetNumberOfValues(), w_vtkDataArray->getVtkData()->GetDataTypeSize());
+	return true;
 }
 
 void ResqmlAbstractRepresentationToVtkPartitionedDataSet::deleteDataArray(const std::string &p_uuid)
@@ -119,7 +219,11 @@ void ResqmlAbstractRepresentationToVtkPartitionedDataSet::registerSubRep()
 
 void ResqmlAbstractRepresentationToVtkPartitionedDataSet::unregisterSubRep()
 {
-	--_subrepPointerOnPointsCount;
+	// a subrepresentation which has not been loaded has never been registered
+	if (_subrepPointerOnPointsCount > 0)
+	{
+		--_subrepPointerOnPointsCount;
+	}
 }
 
 unsigned int ResqmlAbstractRepresentationToVtkPartitionedDataSet::subRepLinkedCount()
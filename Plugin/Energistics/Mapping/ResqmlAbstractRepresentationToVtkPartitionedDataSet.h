@@ -25,6 +25,7 @@ under the License.
 // include VTK library
 #include <vtkSmartPointer.h>
 #include <vtkPartitionedDataSet.h>
+#include <vtkDataArray.h>
 
 // include F2i-consulting Energistics Standards API
 #include <fesapi/resqml2/AbstractRepresentation.h>
@@ -32,6 +33,8 @@ under the License.
 // include F2i-consulting Energistics Standards Paraview Plugin
 #include "CommonAbstractObjectToVtkPartitionedDataSet.h"
 
+class ResqmlPropertyToVtkDataArray;
+
 /** @brief	transform a RESQML abstract representation to vtkPartitionedDataSet
  */
 class ResqmlAbstractRepresentationToVtkPartitionedDataSet : public CommonAbstractObjectToVtkPartitionedDataSet
@@ -57,6 +60,24 @@ public:
 	 */
 	void addDataArray(const std::string &p_uuid, uint32_t p_patchIndex = 0);
 
+	/**
+	 * read the values of a resqml property without adding them to VtkPartitionedDataSet (the representation must be loaded)
+	 */
+	ResqmlPropertyToVtkDataArray *createDataArray(const std::string &p_uuid, uint32_t p_patchIndex = 0) const;
+
+	/**
+	 * add a resqml property already read by createDataArray to VtkPartitionedDataSet (take the ownership of p_dataArray)
+	 */
+	void addDataArray(const std::string &p_uuid, ResqmlPropertyToVtkDataArray *p_dataArray);
+
+	/**
+	 * replace the values of the property p_oldUuid by the ones of p_newUuid (e.g. another time step) at the same index and
+	 * with the same name in the dataset. p_newDataArray (if any) holds the values already read: the mapper takes its ownership
+	 * and its array replaces the old one.
+	 * @return false if the values cannot be replaced (different value type or count): nothing has changed and p_newDataArray is not owned
+	 */
+	bool replaceDataArray(const std::string &p_oldUuid, const std::string &p_newUuid, ResqmlPropertyToVtkDataArray *p_newDataArray = nullptr);
+
 	/**
 	 * remove a resqml property to VtkPartitionedDataSet
 	 */
@@ -72,19 +93,39 @@ public:
 protected:
 	const RESQML2_NS::AbstractRepresentation *getResqmlData() const { return _resqmlData; }
 
+	/**
+	 * @return the property p_uuid of the representation (throw if the representation does not contain it)
+	 */
+	RESQML2_NS::AbstractValuesProperty const *getValuesProperty(const std::string &p_uuid) const;
+
+	/**
+	 * @return the array added to the cell data of the output for the values of the cells of the representation
+	 * (the array itself unless the output cells are not the cells of the representation)
+	 */
+	virtual vtkSmartPointer<vtkDataArray> mapCellValues(vtkDataArray *p_cellValues) const { return p_cellValues; }
+
 	uint32_t _subrepPointerOnPointsCount;
 
 	uint64_t _pointCount = 0;
 	uint32_t _iCellCount = 0; // = cellcount if not ijkGrid
 	uint32_t _jCellCount = 1;
 	uint32_t _kCellCount = 1;
+	// I/J/K block of the cells loaded by the process (multi-processor)
+	uint32_t _initIIndex = 0;
+	uint32_t _maxIIndex = 0;
+	uint32_t _initJIndex = 0;
+	uint32_t _maxJIndex = 0;
 	uint32_t _initKIndex = 0;
 	uint32_t _maxKIndex = 0;
 
+	// coarsened preview: a cell every _stride cells of the block along each axis, the first one of each coarse cell
+	uint32_t _stride = 1;
+	uint32_t getCoarseIndex(uint32_t fineIndex) const { return (fineIndex + _stride - 1) / _stride; }
+
 	bool _isHyperslabed = false;
 
 	const RESQML2_NS::AbstractRepresentation *_resqmlData;
 
-	std::unordered_map<std::string, class ResqmlPropertyToVtkDataArray *> _uuidToVtkDataArray;
+	std::unordered_map<std::string, ResqmlPropertyToVtkDataArray *> _uuidToVtkDataArray;
 };
 #endif
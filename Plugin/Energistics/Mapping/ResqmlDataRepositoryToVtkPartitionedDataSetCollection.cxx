@@ -30,13 +30,22 @@ VtkAssembly => TreeView:
 #include "ResqmlDataRepositoryToVtkPartitionedDataSetCollection.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include <set>
 #include <list>
 #include <regex>
 #include <numeric>
 #include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <thread>
 
 // VTK includes
 #include <vtkPartitionedDataSetCollection.h>
@@ -44,12 +53,16 @@ VtkAssembly => TreeView:
 #include <vtkInformation.h>
 #include <vtkDataAssembly.h>
 #include <vtkDataArraySelection.h>
+#include <vtkPoints.h>
+#include <vtkPointSet.h>
 #include <vtkResourceFileLocator.h>
+#include <vtksys/MD5.h>
 #include <vtksys/SystemTools.hxx>
 
 // FESAPI includes
 #include <fesapi/common/DataObjectRepository.h>
 #include <fesapi/common/EpcDocument.h>
+#include <fesapi/eml2/AbstractHdfProxy.h>
 #include <fesapi/eml2/TimeSeries.h>
 #include <fesapi/resqml2/Grid2dRepresentation.h>
 #include <fesapi/resqml2/AbstractFeatureInterpretation.h>
@@ -73,8 +86,6 @@ VtkAssembly => TreeView:
 #include <fesapi/witsml2_1/Well.h>
 
 #ifdef WITH_ETP_SSL
-#include <thread>
-
 #include <fetpapi/etp/fesapi/FesapiHdfProxy.h>
 
 #include <fetpapi/etp/ProtocolHandlers/DataspaceHandlers.h>
@@ -96,6 +107,7 @@ VtkAssembly => TreeView:
 #include "Mapping/WitsmlWellboreCompletionToVtkPartitionedDataSet.h"
 #include "Mapping/WitsmlWellboreCompletionPerforationToVtkPolyData.h"
 #include "Mapping/CommonAbstractObjectSetToVtkPartitionedDataSetSet.h"
+#include "Mapping/ResqmlPropertyToVtkDataArray.h"
 
 extern "C" const char * GetEnergisticsVersion() {
     return PROJECT_VERSION;
@@ -107,7 +119,21 @@ ResqmlDataRepositoryToVtkPartitionedDataSetCollection::ResqmlDataRepositoryToVtk
       _output(vtkSmartPointer<vtkPartitionedDataSetCollection>::New()),
       _nodeIdToMapper(),
       _currentSelection(),
-      _oldSelection()
+      _oldSelection(),
+      _lazyLoading(false),
+      _useCache(false),
+      _writeCache(true),
+      _numberOfThreads(1),
+      _singlePrecision(false),
+      _ghostLevels(0),
+      _stride(1),
+      _surfaceOnly(false),
+      _cacheSizeMB(0),
+      _numberOfPrefetchedTimeSteps(2),
+      _stopBackgroundTask(false),
+      _hdfIdleTimeout(10),
+      _nbProcess(1),
+      _processId(0)
 {
     auto w_assembly = vtkSmartPointer<vtkDataAssembly>::New();
     w_assembly->SetRootNodeName("data");
@@ -130,11 +156,14 @@ ResqmlDataRepositoryToVtkPartitionedDataSetCollection::ResqmlDataRepositoryToVtk
 
 ResqmlDataRepositoryToVtkPartitionedDataSetCollection::~ResqmlDataRepositoryToVtkPartitionedDataSetCollection()
 {
-    delete _repository;
-    for (const auto &w_keyVal : _nodeIdToMapper)
+    stopBackgroundTask();
+    deleteAllMappers();
+    for (COMMON_NS::EpcDocument *w_epcDocument : _epcDocuments)
     {
-        delete w_keyVal.second;
+        w_epcDocument->close();
+        delete w_epcDocument;
     }
+    delete _repository;
 }
 
 MapperType getMapperType(TreeViewNodeType p_type)
@@ -202,6 +231,64 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::MakeValidNode
     return w_result;
 }
 
+//----------------------------------------------------------------------------
+int ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addNode(const std::string &p_nodeName, int p_parentNodeId, const std::string &p_label, TreeViewNodeType p_type)
+{
+    const int w_nodeId = _output->GetDataAssembly()->AddNode(p_nodeName.c_str(), p_parentNodeId);
+    if (w_nodeId != -1)
+    {
+        _output->GetDataAssembly()->SetAttribute(w_nodeId, "label", p_label.c_str());
+        _output->GetDataAssembly()->SetAttribute(w_nodeId, "type", std::to_string(static_cast<int>(p_type)).c_str());
+        _nodeNameToNodeId[p_nodeName] = w_nodeId;
+        _nodeIdToType[w_nodeId] = p_type;
+    }
+    return w_nodeId;
+}
+
+//----------------------------------------------------------------------------
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::removeNode(int p_nodeId)
+{
+    // vtkDataAssembly::RemoveNode also removes the whole subtree
+    std::vector<int> w_nodeIds = _output->GetDataAssembly()->GetChildNodes(p_nodeId, true);
+    w_nodeIds.push_back(p_nodeId);
+    for (const int w_nodeId : w_nodeIds)
+    {
+        _nodeNameToNodeId.erase(_output->GetDataAssembly()->GetNodeName(w_nodeId));
+        _nodeIdToType.erase(w_nodeId);
+    }
+    _output->GetDataAssembly()->RemoveNode(p_nodeId);
+}
+
+//----------------------------------------------------------------------------
+int ResqmlDataRepositoryToVtkPartitionedDataSetCollection::findNode(const std::string &p_nodeName) const
+{
+    const auto w_it = _nodeNameToNodeId.find(p_nodeName);
+    return w_it == _nodeNameToNodeId.end() ? -1 : w_it->second;
+}
+
+//----------------------------------------------------------------------------
+TreeViewNodeType ResqmlDataRepositoryToVtkPartitionedDataSetCollection::getNodeType(int p_nodeId) const
+{
+    const auto w_it = _nodeIdToType.find(p_nodeId);
+    return w_it == _nodeIdToType.end() ? TreeViewNodeType::Unknown : w_it->second;
+}
+
+//----------------------------------------------------------------------------
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::rebuildNodeIndex()
+{
+    _nodeNameToNodeId.clear();
+    _nodeIdToType.clear();
+    for (const int w_nodeId : _output->GetDataAssembly()->GetChildNodes(0, true))
+    {
+        _nodeNameToNodeId[_output->GetDataAssembly()->GetNodeName(w_nodeId)] = w_nodeId;
+        uint32_t w_typeValue;
+        if (_output->GetDataAssembly()->GetAttribute(w_nodeId, "type", w_typeValue))
+        {
+            _nodeIdToType[w_nodeId] = static_cast<TreeViewNodeType>(w_typeValue);
+        }
+    }
+}
+
 std::string SimplifyXmlTag(std::string p_typeRepresentation)
 {
     std::string w_suffix = "Representation";
@@ -222,6 +309,7 @@ std::string SimplifyXmlTag(std::string p_typeRepresentation)
 //----------------------------------------------------------------------------
 std::vector<std::string> ResqmlDataRepositoryToVtkPartitionedDataSetCollection::connect(const std::string &p_etpUrl, const std::string &p_dataPartition, const std::string &p_authConnection)
 {
+    stopBackgroundTask();
     std::vector<std::string> w_result;
 #ifdef WITH_ETP_SSL
     boost::uuids::random_generator w_gen;
@@ -310,6 +398,7 @@ std::vector<std::string> ResqmlDataRepositoryToVtkPartitionedDataSetCollection::
 //----------------------------------------------------------------------------
 void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::disconnect()
 {
+    stopBackgroundTask();
 #ifdef WITH_ETP_SSL
     _session->close();
 #endif
@@ -318,277 +407,964 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::disconnect()
 //----------------------------------------------------------------------------
 std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addFile(const char *p_fileName)
 {
-
-    COMMON_NS::EpcDocument w_pck(p_fileName);
-    std::string w_message = w_pck.deserializeInto(*_repository);
-    w_pck.close();
-    _files.insert(p_fileName);
-    w_message += buildDataAssemblyFromDataObjectRepo(p_fileName);
-    return w_message;
+    return addFiles(std::vector<std::string>{p_fileName});
 }
 
 //----------------------------------------------------------------------------
-void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::closeHdfProxies()
+std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addFiles(const std::vector<std::string> &p_fileNames)
 {
-    for (EML2_NS::AbstractHdfProxy* proxy : _repository->getDataObjects<EML2_NS::AbstractHdfProxy>()) {
-        proxy->close();
+    stopBackgroundTask();
+
+    // The files are read concurrently (see deserializeFiles) and the tree is built only once.
+    std::string w_message;
+    std::string w_fileNames;
+    _loadingTimes.clear();
+    _filePhaseTimes.clear();
+    // the added files may replace the geometry of the grids already checked
+    _ijkGridHyperslabingCapacities.clear();
+    const auto w_tStart = std::chrono::high_resolution_clock::now();
+    const std::vector<std::string> w_uuidsBefore = _repository->getUuids();
+
+    // the cache only describes the tree of the files it has been built from
+    const bool w_useCache = _useCache && _files.empty() && !p_fileNames.empty();
+    std::string w_cacheKey;
+    if (w_useCache)
+    {
+        w_cacheKey = computeCacheKey(p_fileNames);
+        if (!w_cacheKey.empty() && loadCache(p_fileNames, w_cacheKey, w_message))
+        {
+            const double w_cacheTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - w_tStart).count();
+            _filePhaseTimes.emplace_back("cacheLoad", w_cacheTime);
+            _loadingTimes += std::to_string(p_fileNames.size()) + " file(s) loaded from cache in " + std::to_string(w_cacheTime) + "ms.\n";
+            return w_message;
+        }
     }
-}
-
-//----------------------------------------------------------------------------
-std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addDataspace(const char *p_dataspace)
-{
-#ifdef WITH_ETP_SSL
-    //************ LIST RESOURCES ************
-    Energistics::Etp::v12::Datatypes::Object::ContextInfo w_ctxInfo;
-    w_ctxInfo.uri = p_dataspace;
-    w_ctxInfo.depth = 0;
-    w_ctxInfo.navigableEdges = Energistics::Etp::v12::Datatypes::Object::RelationshipKind::Both;
-    w_ctxInfo.includeSecondaryTargets = false;
-    w_ctxInfo.includeSecondarySources = false;
-    const auto w_resources = _session->getResources(w_ctxInfo, Energistics::Etp::v12::Datatypes::Object::ContextScopeKind::targets);
 
-    //************ GET ALL DATAOBJECTS ************
-    _repository->setHdfProxyFactory(new ETP_NS::FesapiHdfProxyFactory(_session.get()));
-    if (!w_resources.empty())
+    const auto w_tDeserializationStart = std::chrono::high_resolution_clock::now();
+    w_message += deserializeFiles(p_fileNames);
+    _filePhaseTimes.emplace_back("deserialize", std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - w_tDeserializationStart).count());
+    for (const std::string &w_fileName : p_fileNames)
     {
-        std::map<std::string, std::string> w_query;
-        for (size_t w_i = 0; w_i < w_resources.size(); ++w_i)
-        {
-            w_query[std::to_string(w_i)] = w_resources[w_i].uri;
-        }
-        const auto w_dataobjects = _session->getDataObjects(w_query);
-        for (auto &w_datoObject : w_dataobjects)
-        {
-            _repository->addOrReplaceGsoapProxy(w_datoObject.second.data,
-                                                ETP_NS::EtpHelpers::getDataObjectType(w_datoObject.second.resource.uri),
-                                                ETP_NS::EtpHelpers::getDataspaceUri(w_datoObject.second.resource.uri));
-        }
+        w_fileNames += w_fileNames.empty() ? w_fileName : ", " + w_fileName;
     }
-    else
+
+    const auto w_tTreeStart = std::chrono::high_resolution_clock::now();
+    w_message += buildDataAssemblyFromDataObjectRepo(w_fileNames.c_str(), getUpdatedUuids(w_uuidsBefore));
+    if (w_useCache && _writeCache && !w_cacheKey.empty())
     {
-        vtkOutputWindowDisplayWarningText(("There is no dataobject in the dataspace : " + std::string(p_dataspace) + "\n").c_str());
+        saveCache(p_fileNames, w_cacheKey);
     }
-#endif
-    return buildDataAssemblyFromDataObjectRepo("");
+    const auto w_tEnd = std::chrono::high_resolution_clock::now();
+    _filePhaseTimes.emplace_back("assemblyBuild", std::chrono::duration<double, std::milli>(w_tEnd - w_tTreeStart).count());
+    _loadingTimes += "Tree built in " + std::to_string(std::chrono::duration<double, std::milli>(w_tEnd - w_tTreeStart).count()) + "ms.\n" +
+                     std::to_string(p_fileNames.size()) + " file(s) loaded in " + std::to_string(std::chrono::duration<double, std::milli>(w_tEnd - w_tStart).count()) + "ms.\n";
+    return w_message;
 }
 
 namespace
 {
-    auto lexicographicalComparison = [](const COMMON_NS::AbstractObject *p_a, const COMMON_NS::AbstractObject *p_b) -> bool
-    {
-        return p_a->getTitle().compare(p_b->getTitle()) < 0;
+    // content of an EPC document read by a worker thread of deserializeFiles
+    struct EpcDocumentParts
+    {
+        // uuid to xml and content type of the data objects contained in the EPC document
+        std::vector<std::pair<std::string, std::pair<std::string, std::string>>> _parts;
+        // uuid to root path and relative path of the hdf files of the EPC document
+        std::map<std::string, std::pair<std::string, std::string>> _hdfPaths;
+        std::string _message;
+        std::exception_ptr _error;
+        double _time = 0;
     };
 
-    template <typename T>
-    void sortAndAdd(std::vector<T> p_source, std::vector<RESQML2_NS::AbstractRepresentation const *> &p_dest)
+    void readEpcDocumentParts(const std::string &p_fileName, EpcDocumentParts &p_result)
     {
-        std::sort(p_source.begin(), p_source.end(), lexicographicalComparison);
-        std::move(p_source.begin(), p_source.end(), std::inserter(p_dest, p_dest.end()));
+        const auto w_tStart = std::chrono::high_resolution_clock::now();
+        try
+        {
+            // Each worker has its own repository: the fesapi data repositories are not thread safe
+            // but they do not share anything. The EPC document is only opened here.
+            COMMON_NS::EpcDocument w_pck(p_fileName);
+            COMMON_NS::DataObjectRepository w_fileRepository;
+            p_result._message = w_pck.deserializePartiallyInto(w_fileRepository);
+            for (const std::string &w_uuid : w_fileRepository.getUuids())
+            {
+                COMMON_NS::AbstractObject *w_object = w_fileRepository.getDataObjectByUuid(w_uuid);
+                if (w_object != nullptr && w_object->isPartial())
+                {
+                    // empty if the data object is only referenced by the EPC document
+                    std::string w_xml = w_pck.resolvePartial(w_object);
+                    if (!w_xml.empty())
+                    {
+                        p_result._parts.emplace_back(w_uuid, std::make_pair(std::move(w_xml), w_object->getContentType()));
+                    }
+                }
+            }
+            // the hdf proxies are fully deserialized with the relationships of the EPC document which give their hdf file
+            for (EML2_NS::AbstractHdfProxy *w_hdfProxy : w_fileRepository.getDataObjects<EML2_NS::AbstractHdfProxy>())
+            {
+                if (!w_hdfProxy->isPartial())
+                {
+                    p_result._parts.emplace_back(w_hdfProxy->getUuid(), std::make_pair(w_hdfProxy->serializeIntoString(), w_hdfProxy->getContentType()));
+                }
+                p_result._hdfPaths[w_hdfProxy->getUuid()] = std::make_pair(w_pck.getStorageDirectory(), w_hdfProxy->getRelativePath());
+            }
+            w_pck.close();
+        }
+        catch (...)
+        {
+            p_result._error = std::current_exception();
+        }
+        p_result._time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - w_tStart).count();
     }
 }
 
-std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::buildDataAssemblyFromDataObjectRepo(const char *p_fileName)
-{
-    std::vector<RESQML2_NS::AbstractRepresentation const *> w_allReps;
-
-    // create vtkDataAssembly: create treeView in property panel
-    sortAndAdd(_repository->getHorizonGrid2dRepresentationSet(), w_allReps);
-    sortAndAdd(_repository->getIjkGridRepresentationSet(), w_allReps);
-    sortAndAdd(_repository->getAllPolylineSetRepresentationSet(), w_allReps);
-    sortAndAdd(_repository->getAllTriangulatedSetRepresentationSet(), w_allReps);
-    sortAndAdd(_repository->getUnstructuredGridRepresentationSet(), w_allReps);
-
-    // See https://stackoverflow.com/questions/15347123/how-to-construct-a-stdstring-from-a-stdvectorstring
-    std::string w_message = std::accumulate(std::begin(w_allReps), std::end(w_allReps), std::string{},
-                                            [&](std::string &message, RESQML2_NS::AbstractRepresentation const *rep)
-                                            {
-                                                return message += searchRepresentations(rep);
-                                            });
-    // get WellboreTrajectory
-    w_message += searchWellboreTrajectory(p_fileName);
-
-    // get TimeSeries
-    w_message += searchTimeSeries(p_fileName);
-
-    return w_message;
-}
-
-std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchRepresentations(resqml2::AbstractRepresentation const *p_representation, int p_NodeId)
+//----------------------------------------------------------------------------
+std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::deserializeFiles(const std::vector<std::string> &p_fileNames)
 {
-    std::string w_result;
-
-    if (p_representation->isPartial())
+    std::string w_message;
+    if (_lazyLoading)
     {
-        // check if it has already been added
-        // not exist => not loaded
-        if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + p_representation->getUuid()).c_str()) == -1)
+        for (const std::string &w_fileName : p_fileNames)
         {
-            return "Partial representation with UUID \"" + p_representation->getUuid() + "\" is not loaded.\n";
-        } /******* TODO ********/ // exist but not the same type ?
+            const auto w_tFileStart = std::chrono::high_resolution_clock::now();
+            w_message += deserializeFile(w_fileName.c_str(), true);
+            _loadingTimes += w_fileName + " deserialized in " +
+                             std::to_string(std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - w_tFileStart).count()) + "ms.\n";
+        }
+        return w_message;
     }
-    else
-    {
-        // The leading underscore is forced by VTK which does not support a node name starting with a digit (probably because it is a QNAME).
-        const std::string w_nodeName = "_" + p_representation->getUuid();
-        const int w_existingNodeId = _output->GetDataAssembly()->FindFirstNodeWithName(w_nodeName.c_str());
-        if (w_existingNodeId == -1)
-        {
-            p_NodeId = _output->GetDataAssembly()->AddNode(w_nodeName.c_str(), p_NodeId);
-
-            auto const *w_subrep = dynamic_cast<RESQML2_NS::SubRepresentation const *>(p_representation);
-            // To shorten the xmlTag by removing �Representation� from the end.
-
-            std::string w_typeRepresentation = SimplifyXmlTag(p_representation->getXmlTag());
-
-            const std::string w_representationVtkValidName = w_subrep == nullptr
-                                                                 ? this->MakeValidNodeName((w_typeRepresentation + "_" + p_representation->getTitle()).c_str())
-                                                                 : this->MakeValidNodeName((w_typeRepresentation + "_" + w_subrep->getSupportingRepresentation(0)->getTitle() + "_" + p_representation->getTitle()).c_str());
-
-            const TreeViewNodeType w_type = w_subrep == nullptr
-                                                ? TreeViewNodeType::Representation
-                                                : TreeViewNodeType::SubRepresentation;
 
-            _output->GetDataAssembly()->SetAttribute(p_NodeId, "label", w_representationVtkValidName.c_str());
-            _output->GetDataAssembly()->SetAttribute(p_NodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::Representation)).c_str());
-        }
-        else
+    // The worker threads open the files and read them into their own repository.
+    std::vector<EpcDocumentParts> w_documentParts(p_fileNames.size());
+    std::atomic<size_t> w_nextFileIndex(0);
+    auto w_readFiles = [&]() -> void
+    {
+        for (size_t w_fileIndex = w_nextFileIndex++; w_fileIndex < p_fileNames.size(); w_fileIndex = w_nextFileIndex++)
         {
-            p_NodeId = w_existingNodeId;
+            readEpcDocumentParts(p_fileNames[w_fileIndex], w_documentParts[w_fileIndex]);
         }
+    };
+    const size_t w_threadCount = (std::min)(static_cast<size_t>((std::max)(1u, std::thread::hardware_concurrency())), p_fileNames.size());
+    std::vector<std::thread> w_threads;
+    for (size_t w_threadIndex = 1; w_threadIndex < w_threadCount; ++w_threadIndex)
+    {
+        w_threads.emplace_back(w_readFiles);
     }
-
-    // add sub representation with properties (only for ijkGrid and unstructured grid)
-    if (dynamic_cast<RESQML2_NS::AbstractIjkGridRepresentation const *>(p_representation) != nullptr ||
-        dynamic_cast<RESQML2_NS::UnstructuredGridRepresentation const *>(p_representation) != nullptr)
+    w_readFiles();
+    for (std::thread &w_thread : w_threads)
     {
-        w_result += searchSubRepresentation(p_representation, p_NodeId);
+        w_thread.join();
     }
 
-    // add properties to representation
-    w_result += searchProperties(p_representation, p_NodeId);
-
-    return w_result;
-}
-
-std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchSubRepresentation(RESQML2_NS::AbstractRepresentation const *p_representation, int p_nodeParent)
-{
-    std::string w_message = "";
-    try
+    // The shared repository is not modified if any file cannot be read.
+    for (const EpcDocumentParts &w_parts : w_documentParts)
     {
-        auto w_subRepresentationSet = p_representation->getSubRepresentationSet();
-        std::sort(w_subRepresentationSet.begin(), w_subRepresentationSet.end(), lexicographicalComparison);
-
-        w_message = std::accumulate(std::begin(w_subRepresentationSet), std::end(w_subRepresentationSet), std::string{},
-                                    [&](std::string &message, RESQML2_NS::SubRepresentation *b)
-                                    {
-                                        return message += searchRepresentations(b, _output->GetDataAssembly()->GetParent(p_nodeParent));
-                                    });
+        if (w_parts._error)
+        {
+            std::rethrow_exception(w_parts._error);
+        }
     }
-    catch (const std::exception &e)
+
+    // The calling thread then merges all the files at once, in their order, into the shared repository.
+    // The gSOAP proxies of a data object belong to the gSOAP context of its repository: the data objects of the
+    // file repositories cannot be moved and they are added again to the shared repository from their xml.
+    // Only the partial data objects (referenced by a previous file) are replaced.
+    const auto w_tMergeStart = std::chrono::high_resolution_clock::now();
+    for (size_t w_fileIndex = 0; w_fileIndex < p_fileNames.size(); ++w_fileIndex)
     {
-        return "Exception in FESAPI when calling getSubRepresentationSet for uuid : " + p_representation->getUuid() + " : " + e.what() + ".\n";
+        EpcDocumentParts &w_parts = w_documentParts[w_fileIndex];
+        w_message += w_parts._message;
+        for (auto &w_part : w_parts._parts)
+        {
+            COMMON_NS::AbstractObject const *w_object = _repository->getDataObjectByUuid(w_part.first);
+            if (w_object == nullptr || w_object->isPartial())
+            {
+                COMMON_NS::AbstractObject *w_result = _repository->addOrReplaceGsoapProxy(w_part.second.first, w_part.second.second, "");
+                const auto w_hdfPath = w_parts._hdfPaths.find(w_part.first);
+                EML2_NS::AbstractHdfProxy *w_hdfProxy = dynamic_cast<EML2_NS::AbstractHdfProxy *>(w_result);
+                if (w_hdfProxy != nullptr && w_hdfPath != w_parts._hdfPaths.end())
+                {
+                    w_hdfProxy->setRootPath(w_hdfPath->second.first);
+                    w_hdfProxy->setRelativePath(w_hdfPath->second.second);
+                    w_hdfProxy->setOpeningMode(COMMON_NS::DataObjectRepository::openingMode::READ_ONLY);
+                }
+            }
+        }
+        w_parts._parts.clear();
+        _files.insert(p_fileNames[w_fileIndex]);
+        _loadingTimes += p_fileNames[w_fileIndex] + " read in " + std::to_string(w_parts._time) + "ms.\n";
     }
-
+    _loadingTimes += std::to_string(p_fileNames.size()) + " file(s) merged in " +
+                     std::to_string(std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - w_tMergeStart).count()) + "ms.\n";
     return w_message;
 }
 
-int ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchPropertySet(resqml2_0_1::PropertySet const *p_propSet, int p_nodeId)
+//----------------------------------------------------------------------------
+std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::deserializeFile(const char *p_fileName, bool p_partially)
 {
-    if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + p_propSet->getUuid()).c_str()) == -1)
-    { // verify uuid exist in treeview
-      // To shorten the xmlTag by removing �Representation� from the end.
-        resqml2_0_1::PropertySet *w_parent = p_propSet->getParent();
-        if (w_parent != nullptr)
+    std::string w_message;
+    if (p_partially)
+    {
+        // the EPC document stays open until the repository is destroyed in order to deserialize its data objects on demand
+        auto *w_pck = new COMMON_NS::EpcDocument(p_fileName);
+        const std::vector<std::string> w_uuidsBefore = _repository->getUuids();
+        const std::set<std::string> w_existingUuids(w_uuidsBefore.begin(), w_uuidsBefore.end());
+        w_message = w_pck->deserializePartiallyInto(*_repository);
+        for (const std::string &w_uuid : _repository->getUuids())
         {
-            p_nodeId = searchPropertySet(w_parent, p_nodeId);
-        }
-        if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + p_propSet->getUuid()).c_str()) == -1)
-        {
-            const std::string w_vtkValidName = MakeValidNodeName(("Collection_" + p_propSet->getTitle()).c_str());
-            p_nodeId = _output->GetDataAssembly()->AddNode(("_" + p_propSet->getUuid()).c_str(), p_nodeId);
-            _output->GetDataAssembly()->SetAttribute(p_nodeId, "label", w_vtkValidName.c_str());
-            _output->GetDataAssembly()->SetAttribute(p_nodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::Collection)).c_str());
+            if (w_existingUuids.find(w_uuid) == w_existingUuids.end())
+            {
+                _uuidToEpcDocument[w_uuid] = w_pck;
+            }
         }
+        _epcDocuments.push_back(w_pck);
     }
     else
     {
-        return _output->GetDataAssembly()->FindFirstNodeWithName(("_" + p_propSet->getUuid()).c_str());
+        COMMON_NS::EpcDocument w_pck(p_fileName);
+        w_message = w_pck.deserializeInto(*_repository);
+        w_pck.close();
     }
-
-    return p_nodeId;
+    _files.insert(p_fileName);
+    return w_message;
 }
 
-std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchProperties(RESQML2_NS::AbstractRepresentation const *p_representation, int p_nodeParent)
+namespace
 {
-    try
-    {
-        auto w_valuesPropertySet = p_representation->getValuesPropertySet();
-        std::sort(w_valuesPropertySet.begin(), w_valuesPropertySet.end(), lexicographicalComparison);
+    const char *const CACHE_FILE_EXTENSION = ".fesppcache";
+    const char *const CACHE_VERSION = "fesppcache 2";
 
-        int w_propertySetNodeId = p_nodeParent;
-        // property
-        for (auto const *w_property : w_valuesPropertySet)
+    // per user cache directory (empty if it cannot be created)
+    std::string getCacheDirectory()
+    {
+        std::string w_directory;
+#if defined(_WIN32)
+        vtksys::SystemTools::GetEnv("LOCALAPPDATA", w_directory);
+#elif defined(__APPLE__)
+        if (vtksys::SystemTools::GetEnv("HOME", w_directory))
         {
-            for (resqml2_0_1::PropertySet const *w_propertySet : w_property->getPropertySets())
+            w_directory += "/Library/Caches";
+        }
+#else
+        if (!vtksys::SystemTools::GetEnv("XDG_CACHE_HOME", w_directory) || w_directory.empty())
+        {
+            if (vtksys::SystemTools::GetEnv("HOME", w_directory))
             {
-                w_propertySetNodeId = searchPropertySet(w_propertySet, p_nodeParent);
-            }
-
-            const std::string w_vtkValidName = MakeValidNodeName((w_property->getXmlTag() + '_' + w_property->getTitle()).c_str());
-
-            if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_property->getUuid()).c_str()) == -1)
-            { // verify uuid exist in treeview
-                int w_propertyNodeId = _output->GetDataAssembly()->AddNode(("_" + w_property->getUuid()).c_str(), w_propertySetNodeId);
-                _output->GetDataAssembly()->SetAttribute(w_propertyNodeId, "label", w_vtkValidName.c_str());
-                _output->GetDataAssembly()->SetAttribute(w_propertyNodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::Properties)).c_str());
+                w_directory += "/.cache";
             }
         }
+#endif
+        if (w_directory.empty())
+        {
+            return "";
+        }
+        w_directory += "/fespp";
+        if (!vtksys::SystemTools::MakeDirectory(w_directory))
+        {
+            return "";
+        }
+        return w_directory;
     }
-    catch (const std::exception &e)
+
+    // the cache file of a set of files is named from the md5 of their full paths
+    std::string getCacheFileName(const std::vector<std::string> &p_fileNames)
     {
-        return "Exception in FESAPI when calling getValuesPropertySet with representation uuid: " + p_representation->getUuid() + " : " + e.what() + ".\n";
+        const std::string w_directory = getCacheDirectory();
+        if (w_directory.empty())
+        {
+            return "";
+        }
+        std::string w_paths;
+        for (const std::string &w_fileName : p_fileNames)
+        {
+            w_paths += vtksys::SystemTools::CollapseFullPath(w_fileName) + '\n';
+        }
+        vtksysMD5 *w_md5 = vtksysMD5_New();
+        vtksysMD5_Initialize(w_md5);
+        vtksysMD5_Append(w_md5, reinterpret_cast<const unsigned char *>(w_paths.data()), static_cast<int>(w_paths.size()));
+        char w_hex[32];
+        vtksysMD5_FinalizeHex(w_md5, w_hex);
+        vtksysMD5_Delete(w_md5);
+        return w_directory + '/' + std::string(w_hex, 32) + CACHE_FILE_EXTENSION;
+    }
+
+    // md5 of the first and last 64KB of a file: the end of an EPC document is the zip central directory
+    // which holds the crc of every part (empty if the file cannot be read)
+    std::string hashFileEnds(const std::string &p_fileName, long long p_fileSize)
+    {
+        const long long w_chunkSize = 65536;
+        std::ifstream w_file(p_fileName, std::ios::binary);
+        if (!w_file)
+        {
+            return "";
+        }
+        std::vector<char> w_buffer(static_cast<size_t>((std::min)(p_fileSize, 2 * w_chunkSize)));
+        const long long w_headSize = (std::min)(p_fileSize, w_chunkSize);
+        w_file.read(w_buffer.data(), w_headSize);
+        if (p_fileSize > w_headSize)
+        {
+            const long long w_tailSize = static_cast<long long>(w_buffer.size()) - w_headSize;
+            w_file.seekg(p_fileSize - w_tailSize);
+            w_file.read(w_buffer.data() + w_headSize, w_tailSize);
+        }
+        if (!w_file)
+        {
+            return "";
+        }
+        vtksysMD5 *w_md5 = vtksysMD5_New();
+        vtksysMD5_Initialize(w_md5);
+        vtksysMD5_Append(w_md5, reinterpret_cast<const unsigned char *>(w_buffer.data()), static_cast<int>(w_buffer.size()));
+        char w_hex[32];
+        vtksysMD5_FinalizeHex(w_md5, w_hex);
+        vtksysMD5_Delete(w_md5);
+        return std::string(w_hex, 32);
     }
-
-    return "";
 }
 
-int ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchRepresentationSetRepresentation(resqml2::RepresentationSetRepresentation const *p_rsr, int p_nodeId)
+//----------------------------------------------------------------------------
+std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::computeCacheKey(const std::vector<std::string> &p_fileNames) const
 {
-    if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + p_rsr->getUuid()).c_str()) == -1)
-    { // verify uuid exist in treeview
-      // To shorten the xmlTag by removing �Representation� from the end.
-        for (resqml2::RepresentationSetRepresentation *w_rsr : p_rsr->getRepresentationSetRepresentationSet())
+    // Only the ends of the files are read: a file replaced or modified changes its size, its modification time,
+    // its inode or its zip central directory. The latter catches the rewrites within the same second and of the same size.
+    std::string w_key;
+    for (const std::string &w_fileName : p_fileNames)
+    {
+        vtksys::SystemTools::Stat_t w_stat;
+        if (vtksys::SystemTools::Stat(w_fileName, &w_stat) != 0)
         {
-            p_nodeId = searchRepresentationSetRepresentation(w_rsr, p_nodeId);
+            return "";
         }
-        if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + p_rsr->getUuid()).c_str()) == -1)
+        const std::string w_hash = hashFileEnds(w_fileName, static_cast<long long>(w_stat.st_size));
+        if (w_hash.empty())
         {
-            const std::string w_vtkValidName = this->MakeValidNodeName(("Collection_" + p_rsr->getTitle()).c_str());
-            p_nodeId = _output->GetDataAssembly()->AddNode(("_" + p_rsr->getUuid()).c_str(), p_nodeId);
-            _output->GetDataAssembly()->SetAttribute(p_nodeId, "label", w_vtkValidName.c_str());
-            _output->GetDataAssembly()->SetAttribute(p_nodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::Collection)).c_str());
+            return "";
         }
+        w_key += "file " + std::to_string(w_stat.st_size) + ' ' + std::to_string(w_stat.st_mtime) + ' ' +
+                 std::to_string(w_stat.st_ino) + ' ' + w_hash + ' ' + vtksys::SystemTools::CollapseFullPath(w_fileName) + '\n';
     }
-    else
-    {
-        return _output->GetDataAssembly()->FindFirstNodeWithName(("_" + p_rsr->getUuid()).c_str());
-    }
-    return p_nodeId;
+    return w_key;
 }
 
-std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchWellboreTrajectory(const std::string &p_fileName)
+//----------------------------------------------------------------------------
+bool ResqmlDataRepositoryToVtkPartitionedDataSetCollection::loadCache(const std::vector<std::string> &p_fileNames, const std::string &p_cacheKey, std::string &p_message)
 {
-    std::string w_result;
-
-    int w_nodeId = 0;
-    for (auto *w_wellboreTrajectory : _repository->getWellboreTrajectoryRepresentationSet())
+    const std::string w_cacheFileName = getCacheFileName(p_fileNames);
+    if (w_cacheFileName.empty())
     {
-        const auto *w_wellboreFeature = dynamic_cast<RESQML2_NS::WellboreFeature *>(w_wellboreTrajectory->getInterpretation()->getInterpretedFeature());
+        return false;
+    }
+    std::ifstream w_cacheFile(w_cacheFileName, std::ios::binary);
+    if (!w_cacheFile)
+    {
+        return false;
+    }
+    std::stringstream w_buffer;
+    w_buffer << w_cacheFile.rdbuf();
+    const std::string w_content = w_buffer.str();
+
+    // stale cache: another version or at least one file has changed
+    const std::string w_header = std::string(CACHE_VERSION) + '\n' + p_cacheKey;
+    if (w_content.compare(0, w_header.size(), w_header) != 0)
+    {
+        return false;
+    }
+
+    std::istringstream w_stream(w_content.substr(w_header.size()));
+    std::vector<double> w_timesStep;
+    std::map<std::string, std::map<std::string, std::map<double, std::string>>> w_timeSeries;
+    std::vector<std::string> w_uuids;
+    bool w_hasAssembly = false;
+    std::string w_line;
+    while (std::getline(w_stream, w_line))
+    {
+        std::istringstream w_lineStream(w_line);
+        std::string w_tag;
+        w_lineStream >> w_tag;
+        if (w_tag == "times")
+        {
+            size_t w_count = 0;
+            w_lineStream >> w_count;
+            for (size_t w_i = 0; w_i < w_count; ++w_i)
+            {
+                double w_time;
+                w_lineStream >> w_time;
+                w_timesStep.push_back(w_time);
+            }
+        }
+        else if (w_tag == "ts")
+        {
+            std::string w_timeSeriesUuid, w_nodeName, w_propertyUuid;
+            double w_index;
+            w_lineStream >> w_timeSeriesUuid >> w_nodeName >> w_index >> w_propertyUuid;
+            w_timeSeries[w_timeSeriesUuid][w_nodeName][w_index] = w_propertyUuid;
+        }
+        else if (w_tag == "object")
+        {
+            std::string w_uuid;
+            w_lineStream >> w_uuid;
+            w_uuids.push_back(w_uuid);
+        }
+        else if (w_tag == "assembly")
+        {
+            w_hasAssembly = true;
+            break;
+        }
+    }
+    if (!w_hasAssembly)
+    {
+        return false;
+    }
+    const std::string w_xml((std::istreambuf_iterator<char>(w_stream)), std::istreambuf_iterator<char>());
+    vtkNew<vtkDataAssembly> w_assembly;
+    if (!w_assembly->InitializeFromXML(w_xml.c_str()))
+    {
+        return false;
+    }
+
+    // only the tree comes from the cache: the data objects are deserialized as without cache
+    std::string w_fileNames;
+    for (const std::string &w_fileName : p_fileNames)
+    {
+        p_message += deserializeFile(w_fileName.c_str(), _lazyLoading);
+        w_fileNames += w_fileNames.empty() ? w_fileName : ", " + w_fileName;
+    }
+
+    // the summary of the data objects detects a cache which does not match the files
+    for (const std::string &w_uuid : w_uuids)
+    {
+        if (_repository->getDataObjectByUuid(w_uuid) == nullptr)
+        {
+            p_message += "The cache " + w_cacheFileName + " does not match the files: the tree is rebuilt.\n";
+            p_message += buildDataAssemblyFromDataObjectRepo(w_fileNames.c_str(), getUpdatedUuids(std::vector<std::string>()));
+            return true;
+        }
+    }
+
+    _output->GetDataAssembly()->DeepCopy(w_assembly);
+    rebuildNodeIndex();
+    _timesStep = w_timesStep;
+    _timeSeriesUuidAndTitleToIndexAndPropertiesUuid = w_timeSeries;
+    return true;
+}
+
+//----------------------------------------------------------------------------
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::saveCache(const std::vector<std::string> &p_fileNames, const std::string &p_cacheKey) const
+{
+    const std::string w_cacheFileName = getCacheFileName(p_fileNames);
+    if (w_cacheFileName.empty())
+    {
+        return;
+    }
+    const std::string w_tmpFileName = w_cacheFileName + ".tmp";
+    {
+        std::ofstream w_cacheFile(w_tmpFileName, std::ios::binary | std::ios::trunc);
+        if (!w_cacheFile)
+        {
+            // e.g. full disk: no cache
+            return;
+        }
+        w_cacheFile << std::setprecision(std::numeric_limits<double>::max_digits10);
+        w_cacheFile << CACHE_VERSION << '\n'
+                    << p_cacheKey;
+
+        w_cacheFile << "times " << _timesStep.size();
+        for (const double w_time : _timesStep)
+        {
+            w_cacheFile << ' ' << w_time;
+        }
+        w_cacheFile << '\n';
+
+        for (const auto &w_timeSeries : _timeSeriesUuidAndTitleToIndexAndPropertiesUuid)
+        {
+            for (const auto &w_title : w_timeSeries.second)
+            {
+                for (const auto &w_indexAndProperty : w_title.second)
+                {
+                    w_cacheFile << "ts " << w_timeSeries.first << ' ' << w_title.first << ' ' << w_indexAndProperty.first << ' ' << w_indexAndProperty.second << '\n';
+                }
+            }
+        }
+
+        for (const std::string &w_uuid : _repository->getUuids())
+        {
+            COMMON_NS::AbstractObject const *w_object = _repository->getDataObjectByUuid(w_uuid);
+            if (w_object != nullptr)
+            {
+                w_cacheFile << "object " << w_uuid << ' ' << w_object->getContentType() << '\n';
+            }
+        }
+
+        w_cacheFile << "assembly\n"
+                    << _output->GetDataAssembly()->SerializeToXML(vtkIndent());
+        if (!w_cacheFile)
+        {
+            w_cacheFile.close();
+            vtksys::SystemTools::RemoveFile(w_tmpFileName);
+            return;
+        }
+    }
+    // readers (e.g. other processes) never see a partially written cache
+    vtksys::SystemTools::RenameFile(w_tmpFileName, w_cacheFileName);
+}
+
+//----------------------------------------------------------------------------
+COMMON_NS::AbstractObject *ResqmlDataRepositoryToVtkPartitionedDataSetCollection::resolvePartial(COMMON_NS::AbstractObject *p_object)
+{
+    if (p_object == nullptr || !p_object->isPartial())
+    {
+        return p_object;
+    }
+    const auto w_epcDocument = _uuidToEpcDocument.find(p_object->getUuid());
+    if (w_epcDocument == _uuidToEpcDocument.end())
+    {
+        // only referenced, the data object is not contained in a lazily opened EPC document
+        return p_object;
+    }
+    const std::string w_xml = w_epcDocument->second->resolvePartial(p_object);
+    if (w_xml.empty())
+    {
+        return p_object;
+    }
+    COMMON_NS::AbstractObject *w_result = _repository->addOrReplaceGsoapProxy(w_xml, p_object->getContentType(), "");
+
+    // the targets (crs, interpretation, supporting representation, hdf proxy, ...) are required to read the data object
+    for (COMMON_NS::AbstractObject *w_target : _repository->getTargetObjects(w_result))
+    {
+        resolvePartial(w_target);
+    }
+    return w_result;
+}
+
+namespace
+{
+    // a wellbore must be updated in the tree if its trajectory, its feature or its witsml wellbore (e.g. new completion) is updated
+    bool isWellboreUpdated(RESQML2_NS::WellboreTrajectoryRepresentation const *p_trajectory, const std::set<std::string> &p_updatedUuids)
+    {
+        if (p_updatedUuids.find(p_trajectory->getUuid()) != p_updatedUuids.end())
+        {
+            return true;
+        }
+        if (p_trajectory->isPartial() || p_trajectory->getInterpretation() == nullptr)
+        {
+            return false;
+        }
+        auto const *w_wellboreFeature = dynamic_cast<RESQML2_NS::WellboreFeature *>(p_trajectory->getInterpretation()->getInterpretedFeature());
+        if (w_wellboreFeature == nullptr)
+        {
+            return false;
+        }
+        if (p_updatedUuids.find(w_wellboreFeature->getUuid()) != p_updatedUuids.end())
+        {
+            return true;
+        }
+        return !w_wellboreFeature->isPartial() &&
+               w_wellboreFeature->getWitsmlWellbore() != nullptr &&
+               p_updatedUuids.find(w_wellboreFeature->getWitsmlWellbore()->getUuid()) != p_updatedUuids.end();
+    }
+}
+
+//----------------------------------------------------------------------------
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::resolveWellboresAndTimeSeries(const std::set<std::string> &p_updatedUuids)
+{
+    // Resolving a data object may replace its wrapper: always work on uuids and get the data objects again afterwards.
+    auto w_getUuids = [](const std::vector<COMMON_NS::AbstractObject *> &p_objects) -> std::vector<std::string>
+    {
+        std::vector<std::string> w_uuids;
+        for (auto const *w_object : p_objects)
+        {
+            w_uuids.push_back(w_object->getUuid());
+        }
+        return w_uuids;
+    };
+
+    std::vector<COMMON_NS::AbstractObject *> w_trajectories;
+    for (auto *w_trajectory : _repository->getWellboreTrajectoryRepresentationSet())
+    {
+        if (isWellboreUpdated(w_trajectory, p_updatedUuids))
+        {
+            w_trajectories.push_back(w_trajectory);
+        }
+    }
+    for (const std::string &w_trajectoryUuid : w_getUuids(w_trajectories))
+    {
+        auto *w_trajectory = dynamic_cast<RESQML2_NS::WellboreTrajectoryRepresentation *>(resolvePartial(_repository->getDataObjectByUuid(w_trajectoryUuid)));
+        if (w_trajectory == nullptr || w_trajectory->isPartial())
+        {
+            continue;
+        }
+
+        // frames, channels and markers
+        std::vector<COMMON_NS::AbstractObject *> w_frames;
+        for (auto *w_frame : w_trajectory->getWellboreFrameRepresentationSet())
+        {
+            w_frames.push_back(w_frame);
+        }
+        for (const std::string &w_frameUuid : w_getUuids(w_frames))
+        {
+            auto *w_frame = dynamic_cast<RESQML2_NS::WellboreFrameRepresentation *>(resolvePartial(_repository->getDataObjectByUuid(w_frameUuid)));
+            if (w_frame != nullptr)
+            {
+                std::vector<COMMON_NS::AbstractObject *> w_channels;
+                for (auto *w_channel : w_frame->getValuesPropertySet())
+                {
+                    w_channels.push_back(w_channel);
+                }
+                for (const std::string &w_channelUuid : w_getUuids(w_channels))
+                {
+                    resolvePartial(_repository->getDataObjectByUuid(w_channelUuid));
+                }
+            }
+        }
+
+        // completions
+        auto *w_trajectoryResolved = _repository->getDataObjectByUuid<RESQML2_NS::WellboreTrajectoryRepresentation>(w_trajectoryUuid);
+        if (w_trajectoryResolved->getInterpretation() == nullptr)
+        {
+            continue;
+        }
+        auto const *w_wellboreFeature = dynamic_cast<RESQML2_NS::WellboreFeature *>(w_trajectoryResolved->getInterpretation()->getInterpretedFeature());
+        if (w_wellboreFeature != nullptr && !w_wellboreFeature->isPartial() && w_wellboreFeature->getWitsmlWellbore() != nullptr)
+        {
+            std::vector<COMMON_NS::AbstractObject *> w_completions;
+            for (auto *w_completion : w_wellboreFeature->getWitsmlWellbore()->getWellboreCompletionSet())
+            {
+                w_completions.push_back(w_completion);
+            }
+            for (const std::string &w_completionUuid : w_getUuids(w_completions))
+            {
+                resolvePartial(_repository->getDataObjectByUuid(w_completionUuid));
+            }
+        }
+    }
+
+    // time series and their properties (the time stamp of a property is in its xml)
+    std::vector<COMMON_NS::AbstractObject *> w_timeSeriesSet;
+    for (auto *w_timeSeries : _repository->getTimeSeriesSet())
+    {
+        if (p_updatedUuids.find(w_timeSeries->getUuid()) != p_updatedUuids.end())
+        {
+            w_timeSeriesSet.push_back(w_timeSeries);
+        }
+    }
+    for (const std::string &w_timeSeriesUuid : w_getUuids(w_timeSeriesSet))
+    {
+        auto *w_timeSeries = dynamic_cast<EML2_NS::TimeSeries *>(resolvePartial(_repository->getDataObjectByUuid(w_timeSeriesUuid)));
+        if (w_timeSeries != nullptr)
+        {
+            std::vector<COMMON_NS::AbstractObject *> w_properties;
+            for (auto *w_property : w_timeSeries->getPropertySet())
+            {
+                w_properties.push_back(w_property);
+            }
+            for (const std::string &w_propertyUuid : w_getUuids(w_properties))
+            {
+                resolvePartial(_repository->getDataObjectByUuid(w_propertyUuid));
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::closeHdfProxies()
+{
+    stopBackgroundTask();
+    for (EML2_NS::AbstractHdfProxy* proxy : _repository->getDataObjects<EML2_NS::AbstractHdfProxy>()) {
+        proxy->close();
+    }
+    _hdfFileStates.clear();
+}
+
+//----------------------------------------------------------------------------
+std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addDataspace(const char *p_dataspace)
+{
+    stopBackgroundTask();
+    const std::vector<std::string> w_uuidsBefore = _repository->getUuids();
+#ifdef WITH_ETP_SSL
+    //************ LIST RESOURCES ************
+    Energistics::Etp::v12::Datatypes::Object::ContextInfo w_ctxInfo;
+    w_ctxInfo.uri = p_dataspace;
+    w_ctxInfo.depth = 0;
+    w_ctxInfo.navigableEdges = Energistics::Etp::v12::Datatypes::Object::RelationshipKind::Both;
+    w_ctxInfo.includeSecondaryTargets = false;
+    w_ctxInfo.includeSecondarySources = false;
+    const auto w_resources = _session->getResources(w_ctxInfo, Energistics::Etp::v12::Datatypes::Object::ContextScopeKind::targets);
+
+    //************ GET ALL DATAOBJECTS ************
+    _repository->setHdfProxyFactory(new ETP_NS::FesapiHdfProxyFactory(_session.get()));
+    if (!w_resources.empty())
+    {
+        std::map<std::string, std::string> w_query;
+        for (size_t w_i = 0; w_i < w_resources.size(); ++w_i)
+        {
+            w_query[std::to_string(w_i)] = w_resources[w_i].uri;
+        }
+        const auto w_dataobjects = _session->getDataObjects(w_query);
+        for (auto &w_datoObject : w_dataobjects)
+        {
+            _repository->addOrReplaceGsoapProxy(w_datoObject.second.data,
+                                                ETP_NS::EtpHelpers::getDataObjectType(w_datoObject.second.resource.uri),
+                                                ETP_NS::EtpHelpers::getDataspaceUri(w_datoObject.second.resource.uri));
+        }
+    }
+    else
+    {
+        vtkOutputWindowDisplayWarningText(("There is no dataobject in the dataspace : " + std::string(p_dataspace) + "\n").c_str());
+    }
+#endif
+    return buildDataAssemblyFromDataObjectRepo("", getUpdatedUuids(w_uuidsBefore));
+}
+
+namespace
+{
+    auto lexicographicalComparison = [](const COMMON_NS::AbstractObject *p_a, const COMMON_NS::AbstractObject *p_b) -> bool
+    {
+        return p_a->getTitle().compare(p_b->getTitle()) < 0;
+    };
+
+    template <typename T>
+    void sortAndAdd(std::vector<T> p_source, std::vector<RESQML2_NS::AbstractRepresentation const *> &p_dest, const std::set<std::string> &p_updatedUuids)
+    {
+        p_source.erase(std::remove_if(p_source.begin(), p_source.end(),
+                                      [&p_updatedUuids](const COMMON_NS::AbstractObject *p_object)
+                                      { return p_updatedUuids.find(p_object->getUuid()) == p_updatedUuids.end(); }),
+                       p_source.end());
+        std::sort(p_source.begin(), p_source.end(), lexicographicalComparison);
+        std::move(p_source.begin(), p_source.end(), std::inserter(p_dest, p_dest.end()));
+    }
+}
+
+std::set<std::string> ResqmlDataRepositoryToVtkPartitionedDataSetCollection::getUpdatedUuids(const std::vector<std::string> &p_uuidsBefore) const
+{
+    const std::set<std::string> w_uuidsBefore(p_uuidsBefore.begin(), p_uuidsBefore.end());
+    std::set<std::string> w_result;
+    for (const std::string &w_uuid : _repository->getUuids())
+    {
+        if (w_uuidsBefore.find(w_uuid) == w_uuidsBefore.end())
+        {
+            w_result.insert(w_uuid);
+            // e.g. a new property or a new subrepresentation adds a node to an existing representation
+            for (COMMON_NS::AbstractObject *w_target : _repository->getTargetObjects(_repository->getDataObjectByUuid(w_uuid)))
+            {
+                w_result.insert(w_target->getUuid());
+                // the nodes of a subrepresentation are added with its supporting representation
+                if (dynamic_cast<RESQML2_NS::SubRepresentation *>(w_target) != nullptr)
+                {
+                    for (COMMON_NS::AbstractObject *w_supportingRepresentation : _repository->getTargetObjects(w_target))
+                    {
+                        w_result.insert(w_supportingRepresentation->getUuid());
+                    }
+                }
+            }
+        }
+    }
+    return w_result;
+}
+
+std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::buildDataAssemblyFromDataObjectRepo(const char *p_fileName, const std::set<std::string> &p_updatedUuids)
+{
+    if (!_uuidToEpcDocument.empty())
+    {
+        resolveWellboresAndTimeSeries(p_updatedUuids);
+    }
+
+    std::vector<RESQML2_NS::AbstractRepresentation const *> w_allReps;
+
+    // create vtkDataAssembly: create treeView in property panel
+    sortAndAdd(_repository->getHorizonGrid2dRepresentationSet(), w_allReps, p_updatedUuids);
+    sortAndAdd(_repository->getIjkGridRepresentationSet(), w_allReps, p_updatedUuids);
+    sortAndAdd(_repository->getAllPolylineSetRepresentationSet(), w_allReps, p_updatedUuids);
+    sortAndAdd(_repository->getAllTriangulatedSetRepresentationSet(), w_allReps, p_updatedUuids);
+    sortAndAdd(_repository->getUnstructuredGridRepresentationSet(), w_allReps, p_updatedUuids);
+
+    // See https://stackoverflow.com/questions/15347123/how-to-construct-a-stdstring-from-a-stdvectorstring
+    std::string w_message = std::accumulate(std::begin(w_allReps), std::end(w_allReps), std::string{},
+                                            [&](std::string &message, RESQML2_NS::AbstractRepresentation const *rep)
+                                            {
+                                                return message += searchRepresentations(rep);
+                                            });
+    // get WellboreTrajectory
+    w_message += searchWellboreTrajectory(p_fileName, p_updatedUuids);
+
+    // get TimeSeries
+    w_message += searchTimeSeries(p_fileName, p_updatedUuids);
+
+    return w_message;
+}
+
+std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchRepresentations(resqml2::AbstractRepresentation const *p_representation, int p_NodeId)
+{
+    std::string w_result;
+
+    if (p_representation->isPartial() && _uuidToEpcDocument.find(p_representation->getUuid()) == _uuidToEpcDocument.end())
+    {
+        // check if it has already been added
+        // not exist => not loaded
+        if (findNode("_" + p_representation->getUuid()) == -1)
+        {
+            return "Partial representation with UUID \"" + p_representation->getUuid() + "\" is not loaded.\n";
+        } /******* TODO ********/ // exist but not the same type ?
+    }
+    else
+    {
+        // The leading underscore is forced by VTK which does not support a node name starting with a digit (probably because it is a QNAME).
+        const std::string w_nodeName = "_" + p_representation->getUuid();
+        const int w_existingNodeId = findNode(w_nodeName);
+        if (w_existingNodeId == -1)
+        {
+            auto const *w_subrep = dynamic_cast<RESQML2_NS::SubRepresentation const *>(p_representation);
+            // To shorten the xmlTag by removing �Representation� from the end.
+
+            std::string w_typeRepresentation = SimplifyXmlTag(p_representation->getXmlTag());
+            // a partial representation (lazy loading) is deserialized only when it is loaded
+            const std::string w_title = p_representation->isPartial() && p_representation->getTitle().empty()
+                                            ? p_representation->getUuid()
+                                            : p_representation->getTitle();
+
+            const std::string w_representationVtkValidName = w_subrep == nullptr || w_subrep->isPartial()
+                                                                 ? this->MakeValidNodeName((w_typeRepresentation + "_" + w_title).c_str())
+                                                                 : this->MakeValidNodeName((w_typeRepresentation + "_" + w_subrep->getSupportingRepresentation(0)->getTitle() + "_" + w_title).c_str());
+
+            const TreeViewNodeType w_type = w_subrep == nullptr
+                                                ? TreeViewNodeType::Representation
+                                                : TreeViewNodeType::SubRepresentation;
+
+            p_NodeId = addNode(w_nodeName, p_NodeId, w_representationVtkValidName, TreeViewNodeType::Representation);
+        }
+        else
+        {
+            p_NodeId = w_existingNodeId;
+        }
+    }
+
+    // add sub representation with properties (only for ijkGrid and unstructured grid)
+    if (dynamic_cast<RESQML2_NS::AbstractIjkGridRepresentation const *>(p_representation) != nullptr ||
+        dynamic_cast<RESQML2_NS::UnstructuredGridRepresentation const *>(p_representation) != nullptr)
+    {
+        w_result += searchSubRepresentation(p_representation, p_NodeId);
+    }
+
+    // add properties to representation
+    w_result += searchProperties(p_representation, p_NodeId);
+
+    return w_result;
+}
+
+std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchSubRepresentation(RESQML2_NS::AbstractRepresentation const *p_representation, int p_nodeParent)
+{
+    std::string w_message = "";
+    try
+    {
+        auto w_subRepresentationSet = p_representation->getSubRepresentationSet();
+        std::sort(w_subRepresentationSet.begin(), w_subRepresentationSet.end(), lexicographicalComparison);
+
+        w_message = std::accumulate(std::begin(w_subRepresentationSet), std::end(w_subRepresentationSet), std::string{},
+                                    [&](std::string &message, RESQML2_NS::SubRepresentation *b)
+                                    {
+                                        return message += searchRepresentations(b, _output->GetDataAssembly()->GetParent(p_nodeParent));
+                                    });
+    }
+    catch (const std::exception &e)
+    {
+        return "Exception in FESAPI when calling getSubRepresentationSet for uuid : " + p_representation->getUuid() + " : " + e.what() + ".\n";
+    }
+
+    return w_message;
+}
+
+int ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchPropertySet(resqml2_0_1::PropertySet const *p_propSet, int p_nodeId)
+{
+    if (findNode("_" + p_propSet->getUuid()) == -1)
+    { // verify uuid exist in treeview
+      // To shorten the xmlTag by removing �Representation� from the end.
+        resqml2_0_1::PropertySet *w_parent = p_propSet->isPartial() ? nullptr : p_propSet->getParent();
+        if (w_parent != nullptr)
+        {
+            p_nodeId = searchPropertySet(w_parent, p_nodeId);
+        }
+        if (findNode("_" + p_propSet->getUuid()) == -1)
+        {
+            const std::string w_vtkValidName = MakeValidNodeName(("Collection_" + p_propSet->getTitle()).c_str());
+            p_nodeId = addNode("_" + p_propSet->getUuid(), p_nodeId, w_vtkValidName, TreeViewNodeType::Collection);
+        }
+    }
+    else
+    {
+        return findNode("_" + p_propSet->getUuid());
+    }
+
+    return p_nodeId;
+}
+
+std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchProperties(RESQML2_NS::AbstractRepresentation const *p_representation, int p_nodeParent)
+{
+    try
+    {
+        auto w_valuesPropertySet = p_representation->getValuesPropertySet();
+        std::sort(w_valuesPropertySet.begin(), w_valuesPropertySet.end(), lexicographicalComparison);
+
+        int w_propertySetNodeId = p_nodeParent;
+        // property
+        for (auto const *w_property : w_valuesPropertySet)
+        {
+            for (resqml2_0_1::PropertySet const *w_propertySet : w_property->getPropertySets())
+            {
+                w_propertySetNodeId = searchPropertySet(w_propertySet, p_nodeParent);
+            }
+
+            const std::string w_title = w_property->isPartial() && w_property->getTitle().empty()
+                                            ? w_property->getUuid()
+                                            : w_property->getTitle();
+            const std::string w_vtkValidName = MakeValidNodeName((w_property->getXmlTag() + '_' + w_title).c_str());
+
+            if (findNode("_" + w_property->getUuid()) == -1)
+            { // verify uuid exist in treeview
+                addNode("_" + w_property->getUuid(), w_propertySetNodeId, w_vtkValidName, TreeViewNodeType::Properties);
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        return "Exception in FESAPI when calling getValuesPropertySet with representation uuid: " + p_representation->getUuid() + " : " + e.what() + ".\n";
+    }
+
+    return "";
+}
+
+int ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchRepresentationSetRepresentation(resqml2::RepresentationSetRepresentation const *p_rsr, int p_nodeId)
+{
+    if (findNode("_" + p_rsr->getUuid()) == -1)
+    { // verify uuid exist in treeview
+      // To shorten the xmlTag by removing �Representation� from the end.
+        for (resqml2::RepresentationSetRepresentation *w_rsr : p_rsr->getRepresentationSetRepresentationSet())
+        {
+            p_nodeId = searchRepresentationSetRepresentation(w_rsr, p_nodeId);
+        }
+        if (findNode("_" + p_rsr->getUuid()) == -1)
+        {
+            const std::string w_vtkValidName = this->MakeValidNodeName(("Collection_" + p_rsr->getTitle()).c_str());
+            p_nodeId = addNode("_" + p_rsr->getUuid(), p_nodeId, w_vtkValidName, TreeViewNodeType::Collection);
+        }
+    }
+    else
+    {
+        return findNode("_" + p_rsr->getUuid());
+    }
+    return p_nodeId;
+}
+
+std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchWellboreTrajectory(const std::string &p_fileName, const std::set<std::string> &p_updatedUuids)
+{
+    std::string w_result;
+
+    for (auto *w_wellboreTrajectory : _repository->getWellboreTrajectoryRepresentationSet())
+    {
+        if (!isWellboreUpdated(w_wellboreTrajectory, p_updatedUuids))
+        {
+            continue;
+        }
+        const auto *w_wellboreFeature = dynamic_cast<RESQML2_NS::WellboreFeature *>(w_wellboreTrajectory->getInterpretation()->getInterpretedFeature());
 
-        int w_nodeId = 0;
         int w_initNodeId = 0;
-        if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_wellboreTrajectory->getUuid()).c_str()) == -1)
+        if (findNode("_" + w_wellboreTrajectory->getUuid()) == -1)
         { // verify uuid exist in treeview
           // To shorten the xmlTag by removing �Representation� from the end.
             for (resqml2::RepresentationSetRepresentation *w_rsr : w_wellboreTrajectory->getRepresentationSetRepresentationSet())
@@ -596,12 +1372,10 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchWellbor
                 w_initNodeId = searchRepresentationSetRepresentation(w_rsr);
             }
 
-            if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_wellboreFeature->getUuid()).c_str()) == -1)
+            if (findNode("_" + w_wellboreFeature->getUuid()) == -1)
             {
                 const std::string w_vtkValidName = "Wellbore_" + MakeValidNodeName(w_wellboreFeature->getTitle().c_str());
-                w_initNodeId = _output->GetDataAssembly()->AddNode(("_" + w_wellboreFeature->getUuid()).c_str(), w_initNodeId);
-                _output->GetDataAssembly()->SetAttribute(w_initNodeId, "label", w_vtkValidName.c_str());
-                _output->GetDataAssembly()->SetAttribute(w_initNodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::Wellbore)).c_str());
+                w_initNodeId = addNode("_" + w_wellboreFeature->getUuid(), w_initNodeId, w_vtkValidName, TreeViewNodeType::Wellbore);
             }
 
             if (w_wellboreTrajectory->isPartial())
@@ -610,7 +1384,7 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchWellbor
 
                 const std::string w_vtkValidName = MakeValidNodeName((SimplifyXmlTag(w_wellboreTrajectory->getXmlTag()) + "_" + w_wellboreTrajectory->getTitle()).c_str());
                 // not exist => not loaded
-                if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_vtkValidName).c_str()) == -1)
+                if (findNode("_" + w_vtkValidName) == -1)
                 {
                     w_result = w_result + " Partial UUID: (" + w_wellboreTrajectory->getUuid() + ") is not loaded \n";
                     continue;
@@ -619,11 +1393,14 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchWellbor
             else
             {
                 const std::string w_vtkValidName = MakeValidNodeName((SimplifyXmlTag(w_wellboreTrajectory->getXmlTag()) + '_' + w_wellboreTrajectory->getTitle()).c_str());
-                w_nodeId = _output->GetDataAssembly()->AddNode(("_" + w_wellboreTrajectory->getUuid()).c_str(), w_initNodeId);
-                _output->GetDataAssembly()->SetAttribute(w_nodeId, "label", w_vtkValidName.c_str());
-                _output->GetDataAssembly()->SetAttribute(w_nodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::WellboreTrajectory)).c_str());
+                addNode("_" + w_wellboreTrajectory->getUuid(), w_initNodeId, w_vtkValidName, TreeViewNodeType::WellboreTrajectory);
             }
         }
+        else
+        {
+            // already in the tree: the new frames and completions are added to its wellbore node
+            w_initNodeId = _output->GetDataAssembly()->GetParent(findNode("_" + w_wellboreTrajectory->getUuid()));
+        }
         w_result += searchWellboreFrame(w_wellboreTrajectory, w_initNodeId);
         w_result += searchWellboreCompletion(w_wellboreFeature, w_initNodeId);
     }
@@ -635,36 +1412,29 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchWellbor
     std::string w_result = "";
     for (auto *w_wellboreFrame : p_wellboreTrajectory->getWellboreFrameRepresentationSet())
     {
-        if (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_wellboreFrame->getUuid()).c_str()) == -1)
+        if (findNode("_" + w_wellboreFrame->getUuid()) == -1)
         { // verify uuid exist in treeview
           // common with wellboreMarkerFrame & WellboreFrame
             const std::string w_vtkValidName = MakeValidNodeName((SimplifyXmlTag(w_wellboreFrame->getXmlTag()) + '_' + w_wellboreFrame->getTitle()).c_str());
-            int w_frameNodeId = _output->GetDataAssembly()->AddNode(("_" + w_wellboreFrame->getUuid()).c_str(), p_nodeId);
-            _output->GetDataAssembly()->SetAttribute(w_frameNodeId, "label", w_vtkValidName.c_str());
-
             auto *w_wellboreMarkerFrame = dynamic_cast<RESQML2_NS::WellboreMarkerFrameRepresentation const *>(w_wellboreFrame);
+            const int w_frameNodeId = addNode("_" + w_wellboreFrame->getUuid(), p_nodeId, w_vtkValidName,
+                                              w_wellboreMarkerFrame == nullptr ? TreeViewNodeType::WellboreFrame : TreeViewNodeType::WellboreMarkerFrame);
             if (w_wellboreMarkerFrame == nullptr)
             { // WellboreFrame
-                _output->GetDataAssembly()->SetAttribute(w_frameNodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::WellboreFrame)).c_str());
                 // chanel
                 for (auto *w_property : w_wellboreFrame->getValuesPropertySet())
                 {
                     const std::string w_vtkValidName = MakeValidNodeName((w_property->getXmlTag() + '_' + w_property->getTitle()).c_str());
-                    int w_nodeId = _output->GetDataAssembly()->AddNode(("_" + w_property->getUuid()).c_str(), w_frameNodeId);
-                    _output->GetDataAssembly()->SetAttribute(w_nodeId, "label", w_vtkValidName.c_str());
-                    _output->GetDataAssembly()->SetAttribute(w_nodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::WellboreChannel)).c_str());
+                    addNode("_" + w_property->getUuid(), w_frameNodeId, w_vtkValidName, TreeViewNodeType::WellboreChannel);
                 }
             }
             else
             { // WellboreMarkerFrame
-                _output->GetDataAssembly()->SetAttribute(w_frameNodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::WellboreMarkerFrame)).c_str());
                 // marker
                 for (auto *w_wellboreMarker : w_wellboreMarkerFrame->getWellboreMarkerSet())
                 {
                     const std::string w_vtkValidName = MakeValidNodeName((w_wellboreMarker->getXmlTag() + '_' + w_wellboreMarker->getTitle()).c_str());
-                    int w_nodeId = _output->GetDataAssembly()->AddNode(("_" + w_wellboreMarker->getUuid()).c_str(), w_frameNodeId);
-                    _output->GetDataAssembly()->SetAttribute(w_nodeId, "label", w_vtkValidName.c_str());
-                    _output->GetDataAssembly()->SetAttribute(w_nodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::WellboreMarker)).c_str());
+                    addNode("_" + w_wellboreMarker->getUuid(), w_frameNodeId, w_vtkValidName, TreeViewNodeType::WellboreMarker);
                 }
             }
         }
@@ -682,10 +1452,12 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchWellbor
         {
             for (const auto *w_wellboreCompletion : w_witsmlWellbore->getWellboreCompletionSet())
             {
+                if (findNode("_" + w_wellboreCompletion->getUuid()) != -1)
+                { // already in the tree
+                    continue;
+                }
                 const std::string w_vtkValidName = MakeValidNodeName((SimplifyXmlTag(w_wellboreCompletion->getXmlTag()) + '_' + w_wellboreCompletion->getTitle()).c_str());
-                int w_completionNodeId = _output->GetDataAssembly()->AddNode(("_" + w_wellboreCompletion->getUuid()).c_str(), p_nodeId);
-                _output->GetDataAssembly()->SetAttribute(w_completionNodeId, "label", w_vtkValidName.c_str());
-                _output->GetDataAssembly()->SetAttribute(w_completionNodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::WellboreCompletion)).c_str());
+                int w_completionNodeId = addNode("_" + w_wellboreCompletion->getUuid(), p_nodeId, w_vtkValidName, TreeViewNodeType::WellboreCompletion);
                 // Iterate over the perforations.
                 for (uint64_t w_perforationIndex = 0; w_perforationIndex < w_wellboreCompletion->getConnectionCount(WITSML2_1_NS::WellboreCompletion::WellReservoirConnectionType::PERFORATION); ++w_perforationIndex)
                 {
@@ -741,9 +1513,7 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchWellbor
                     }
                     w_perforationName += "__Skin_" + w_perforationSkin + "__Diam_" + w_perforationDiameter;
 
-                    int w_nodeId = _output->GetDataAssembly()->AddNode(this->MakeValidNodeName(("_" + w_wellboreCompletion->getUuid() + "_" + w_wellboreCompletion->getConnectionUid(WITSML2_1_NS::WellboreCompletion::WellReservoirConnectionType::PERFORATION, w_perforationIndex)).c_str()).c_str(), w_completionNodeId);
-                    _output->GetDataAssembly()->SetAttribute(w_nodeId, "label", MakeValidNodeName((w_perforationName).c_str()).c_str());
-                    _output->GetDataAssembly()->SetAttribute(w_nodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::Perforation)).c_str());
+                    int w_nodeId = addNode(MakeValidNodeName(("_" + w_wellboreCompletion->getUuid() + "_" + w_wellboreCompletion->getConnectionUid(WITSML2_1_NS::WellboreCompletion::WellReservoirConnectionType::PERFORATION, w_perforationIndex)).c_str()), w_completionNodeId, MakeValidNodeName((w_perforationName).c_str()), TreeViewNodeType::Perforation);
                     _output->GetDataAssembly()->SetAttribute(w_nodeId, "connection", w_wellboreCompletion->getConnectionUid(WITSML2_1_NS::WellboreCompletion::WellReservoirConnectionType::PERFORATION, w_perforationIndex).c_str());
                     _output->GetDataAssembly()->SetAttribute(w_nodeId, "skin", w_perforationSkin.c_str());
                     _output->GetDataAssembly()->SetAttribute(w_nodeId, "diameter", w_perforationDiameter.c_str());
@@ -753,10 +1523,8 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchWellbor
     }
     return w_result;
 }
-std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchTimeSeries(const std::string &p_fileName)
+std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchTimeSeries(const std::string &p_fileName, const std::set<std::string> &p_updatedUuids)
 {
-    _timesStep.clear();
-
     std::string w_message = "";
     std::vector<EML2_NS::TimeSeries *> w_timeSeriesSet;
     try
@@ -773,6 +1541,11 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchTimeSer
      ****/
     for (auto const *w_timeSeries : w_timeSeriesSet)
     {
+        // a new property of a time series targets it: the time series is then updated
+        if (p_updatedUuids.find(w_timeSeries->getUuid()) == p_updatedUuids.end())
+        {
+            continue;
+        }
         // get properties link to Times series
         try
         {
@@ -782,8 +1555,13 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchTimeSer
                 if (w_prop->getXmlTag() == RESQML2_NS::ContinuousProperty::XML_TAG ||
                     w_prop->getXmlTag() == RESQML2_NS::DiscreteProperty::XML_TAG)
                 {
-                    auto w_nodeId = (_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_prop->getUuid()).c_str()));
-                    if (w_nodeId == -1)
+                    auto w_nodeId = findNode("_" + w_prop->getUuid());
+                    if (w_nodeId == -1 && p_updatedUuids.find(w_prop->getUuid()) == p_updatedUuids.end())
+                    {
+                        // already grouped in its time series node
+                        continue;
+                    }
+                    else if (w_nodeId == -1)
                     {
                         w_message = w_message + "The property " + w_prop->getUuid() + " is not supported and consequently cannot be associated to its time series.\n";
                         continue;
@@ -820,12 +1598,14 @@ std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::searchTimeSer
                 for (auto node : w_propertyNodeSet)
                 {
                     w_parentNodeId = _output->GetDataAssembly()->GetParent(node);
-                    _output->GetDataAssembly()->RemoveNode(node);
+                    removeNode(node);
                 }
                 std::string w_vtkValidName = MakeValidNodeName((w_timeSeries->getXmlTag() + '_' + w_myPair.first).c_str());
-                auto w_nodeId = _output->GetDataAssembly()->AddNode(("_" + w_timeSeries->getUuid() + w_vtkValidName).c_str(), w_parentNodeId);
-                _output->GetDataAssembly()->SetAttribute(w_nodeId, "label", w_vtkValidName.c_str());
-                _output->GetDataAssembly()->SetAttribute(w_nodeId, "type", std::to_string(static_cast<int>(TreeViewNodeType::TimeSeries)).c_str());
+                const std::string w_timeSeriesNodeName = "_" + w_timeSeries->getUuid() + w_vtkValidName;
+                if (findNode(w_timeSeriesNodeName) == -1)
+                { // the time series node may exist if new time steps have been added
+                    addNode(w_timeSeriesNodeName, w_parentNodeId, w_vtkValidName, TreeViewNodeType::TimeSeries);
+                }
             }
         }
         catch (const std::exception &e)
@@ -878,10 +1658,9 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::clearSelection()
 
 void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::initMapperSet(const TreeViewNodeType p_type, const int p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId)
 {
-    CommonAbstractObjectToVtkPartitionedDataSet *w_caotvpds = nullptr;
     const std::string w_uuid = std::string(_output->GetDataAssembly()->GetNodeName(p_nodeId)).substr(1);
 
-    COMMON_NS::AbstractObject* const w_abstractObject = _repository->getDataObjectByUuid(w_uuid);
+    COMMON_NS::AbstractObject* const w_abstractObject = resolvePartial(_repository->getDataObjectByUuid(w_uuid));
 
     if (p_type == TreeViewNodeType::WellboreCompletion)
     {
@@ -940,11 +1719,11 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::initMapperSet(const
 
 }
 
-void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::loadMapper(const TreeViewNodeType p_type, const int p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId)
+int ResqmlDataRepositoryToVtkPartitionedDataSetCollection::loadMapper(const TreeViewNodeType p_type, const int p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId)
 {
     if (TreeViewNodeType::Representation == p_type)
     {
-        loadRepresentationMapper(p_nodeId, p_nbProcess, p_processId);
+        return loadRepresentationMapper(p_nodeId, p_nbProcess, p_processId);
     } 
     else if (TreeViewNodeType::WellboreTrajectory == p_type)
     {
@@ -954,17 +1733,22 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::loadMapper(const Tre
     {
         loadWellboreTrajectoryMapper(p_nodeId);
     }
+    return p_nodeId;
 }
 
-void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::loadRepresentationMapper(const int p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId)
+int ResqmlDataRepositoryToVtkPartitionedDataSetCollection::loadRepresentationMapper(const int p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId)
 {
     CommonAbstractObjectToVtkPartitionedDataSet* w_caotvpds = nullptr;
+    int w_loadingGroup = p_nodeId;
     const std::string w_uuid = std::string(_output->GetDataAssembly()->GetNodeName(p_nodeId)).substr(1);
-    COMMON_NS::AbstractObject* const w_abstractObject = _repository->getDataObjectByUuid(w_uuid);
+    COMMON_NS::AbstractObject* const w_abstractObject = resolvePartial(_repository->getDataObjectByUuid(w_uuid));
 
     if (dynamic_cast<RESQML2_NS::AbstractIjkGridRepresentation*>(w_abstractObject) != nullptr)
     {
-        w_caotvpds = new ResqmlIjkGridToVtkExplicitStructuredGrid(static_cast<RESQML2_NS::AbstractIjkGridRepresentation*>(w_abstractObject), p_processId, p_nbProcess);
+        auto* w_ijkGridMapper = new ResqmlIjkGridToVtkExplicitStructuredGrid(static_cast<RESQML2_NS::AbstractIjkGridRepresentation*>(w_abstractObject), p_processId, p_nbProcess, _ghostLevels, &_ijkGridHyperslabingCapacities);
+        w_ijkGridMapper->setStride(_stride);
+        w_ijkGridMapper->setSurfaceOnly(_surfaceOnly);
+        w_caotvpds = w_ijkGridMapper;
     }
     else if (dynamic_cast<RESQML2_NS::Grid2dRepresentation*>(w_abstractObject) != nullptr)
     {
@@ -989,42 +1773,47 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::loadRepresentationMa
         if (dynamic_cast<RESQML2_NS::AbstractIjkGridRepresentation*>(w_subRep->getSupportingRepresentation(0)) != nullptr)
         {
             auto* w_supportingGrid = static_cast<RESQML2_NS::AbstractIjkGridRepresentation*>(w_subRep->getSupportingRepresentation(0));
-            if (_nodeIdToMapper.find(_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_supportingGrid->getUuid()).c_str())) == _nodeIdToMapper.end())
+            // the subrepresentation indexes the points of the whole grid at full resolution, whatever the settings of the grid node
+            auto& w_supportingGridMapper = _supportingIjkGridMappers[w_supportingGrid->getUuid()];
+            if (w_supportingGridMapper.first == nullptr)
             {
-                _nodeIdToMapper[_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_supportingGrid->getUuid()).c_str())] = new ResqmlIjkGridToVtkExplicitStructuredGrid(w_supportingGrid);
+                w_supportingGridMapper.first = new ResqmlIjkGridToVtkExplicitStructuredGrid(w_supportingGrid, 0, 1, 0, &_ijkGridHyperslabingCapacities);
+                w_supportingGridMapper.first->setSinglePrecision(_singlePrecision);
             }
-            w_caotvpds = new ResqmlIjkGridSubRepToVtkExplicitStructuredGrid(w_subRep, dynamic_cast<ResqmlIjkGridToVtkExplicitStructuredGrid*>(_nodeIdToMapper[_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_supportingGrid->getUuid()).c_str())]));
+            ++w_supportingGridMapper.second;
+            // the subrepresentations of a grid share its points: they are loaded by the same thread
+            w_loadingGroup = findNode("_" + w_supportingGrid->getUuid());
+            w_caotvpds = new ResqmlIjkGridSubRepToVtkExplicitStructuredGrid(w_subRep, w_supportingGridMapper.first);
         }
         else if (dynamic_cast<RESQML2_NS::UnstructuredGridRepresentation*>(w_subRep->getSupportingRepresentation(0)) != nullptr)
         {
             auto* w_supportingGrid = static_cast<RESQML2_NS::UnstructuredGridRepresentation*>(w_subRep->getSupportingRepresentation(0));
-            if (_nodeIdToMapper.find(_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_supportingGrid->getUuid()).c_str())) == _nodeIdToMapper.end())
+            const int w_supportingGridNodeId = findNode("_" + w_supportingGrid->getUuid());
+            if (_nodeIdToMapper.find(w_supportingGridNodeId) == _nodeIdToMapper.end())
             {
-                _nodeIdToMapper[_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_supportingGrid->getUuid()).c_str())] = new ResqmlUnstructuredGridToVtkUnstructuredGrid(w_supportingGrid);
+                _nodeIdToMapper[w_supportingGridNodeId] = new ResqmlUnstructuredGridToVtkUnstructuredGrid(w_supportingGrid);
+                _nodeIdToMapper[w_supportingGridNodeId]->setSinglePrecision(_singlePrecision);
             }
-            w_caotvpds = new ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid(w_subRep, dynamic_cast<ResqmlUnstructuredGridToVtkUnstructuredGrid*>(_nodeIdToMapper[_output->GetDataAssembly()->FindFirstNodeWithName(("_" + w_supportingGrid->getUuid()).c_str())]));
+            // the subrepresentation shares the points of its supporting grid
+            w_loadingGroup = w_supportingGridNodeId;
+            w_caotvpds = new ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid(w_subRep, dynamic_cast<ResqmlUnstructuredGridToVtkUnstructuredGrid*>(_nodeIdToMapper[w_supportingGridNodeId]));
         }
         else {
             vtkOutputWindowDisplayWarningText(("FESPP only supports IJK Grid or UnstructuredGrid as supporting representation of subrepresentation  (for uuid: " + w_uuid +  ")\n").c_str());
         }
     }
-    _nodeIdToMapper[p_nodeId] = w_caotvpds;
-    try
-    { // load representation
-        _nodeIdToMapper[p_nodeId]->loadVtkObject();
-        return;
-    }
-    catch (const std::exception& e)
+    if (w_caotvpds != nullptr)
     {
-        vtkOutputWindowDisplayErrorText(("Error when rendering uuid: " + w_uuid + "\n" + e.what()).c_str());
-        return;
+        w_caotvpds->setSinglePrecision(_singlePrecision);
+        _nodeIdToMapper[p_nodeId] = w_caotvpds;
     }
+    return w_loadingGroup;
 }
 
 void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::loadWellboreTrajectoryMapper(const int p_nodeId)
 {
     const std::string w_uuid = std::string(_output->GetDataAssembly()->GetNodeName(p_nodeId)).substr(1);
-    COMMON_NS::AbstractObject* const w_abstractObject = _repository->getDataObjectByUuid(w_uuid);
+    COMMON_NS::AbstractObject* const w_abstractObject = resolvePartial(_repository->getDataObjectByUuid(w_uuid));
 
 
     if (dynamic_cast<RESQML2_NS::WellboreTrajectoryRepresentation*>(w_abstractObject) != nullptr)
@@ -1032,17 +1821,77 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::loadWellboreTrajecto
         _nodeIdToMapper[p_nodeId] = new ResqmlWellboreTrajectoryToVtkPolyData(static_cast<RESQML2_NS::WellboreTrajectoryRepresentation*>(w_abstractObject));
     } else {
         vtkOutputWindowDisplayErrorText(("Error object type in vtkDataAssembly for uuid: " + w_uuid + "\n").c_str());
-        return;
     }
-    try
-    { // load representation
-        _nodeIdToMapper[p_nodeId]->loadVtkObject();
-        return;
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::loadMappers(const std::map<int, std::vector<int>> &p_loadingGroups)
+{
+    std::vector<CommonAbstractObjectToVtkPartitionedDataSet *> w_mappers;
+    std::vector<size_t> w_groupEnds;
+    for (const auto &w_group : p_loadingGroups)
+    {
+        for (const int w_nodeId : w_group.second)
+        {
+            w_mappers.push_back(_nodeIdToMapper.at(w_nodeId));
+        }
+        w_groupEnds.push_back(w_mappers.size());
     }
-    catch (const std::exception& e)
+
+    // the errors are displayed by the calling thread
+    std::vector<std::string> w_errors(w_groupEnds.size());
+    auto w_loadGroup = [&](size_t p_groupIndex) -> void
     {
-        vtkOutputWindowDisplayErrorText(("Error when rendering uuid: " + w_uuid + "\n" + e.what()).c_str());
-        return;
+        for (size_t w_mapperIndex = p_groupIndex == 0 ? 0 : w_groupEnds[p_groupIndex - 1]; w_mapperIndex < w_groupEnds[p_groupIndex]; ++w_mapperIndex)
+        {
+            try
+            { // load representation
+                w_mappers[w_mapperIndex]->loadVtkObjectWithStatistics();
+            }
+            catch (const std::exception &e)
+            {
+                w_errors[p_groupIndex] += "Error when rendering uuid: " + w_mappers[w_mapperIndex]->getUuid() + "\n" + e.what() + "\n";
+            }
+        }
+    };
+
+    const size_t w_threadCount = (std::min)(static_cast<size_t>(_numberOfThreads == 0 ? (std::max)(1u, std::thread::hardware_concurrency()) : _numberOfThreads),
+                                            w_groupEnds.size());
+    if (w_threadCount <= 1)
+    {
+        for (size_t w_groupIndex = 0; w_groupIndex < w_groupEnds.size(); ++w_groupIndex)
+        {
+            w_loadGroup(w_groupIndex);
+        }
+    }
+    else
+    {
+        std::atomic<size_t> w_nextGroupIndex(0);
+        auto w_loadGroups = [&]() -> void
+        {
+            for (size_t w_groupIndex = w_nextGroupIndex++; w_groupIndex < w_groupEnds.size(); w_groupIndex = w_nextGroupIndex++)
+            {
+                // fesapi and HDF5 are only called by one thread at a time (see FesapiUnlock in the mappers)
+                CommonAbstractObjectToVtkPartitionedDataSet::FesapiLock w_fesapiLock;
+                w_loadGroup(w_groupIndex);
+            }
+        };
+        std::vector<std::thread> w_threads;
+        for (size_t w_threadIndex = 0; w_threadIndex < w_threadCount; ++w_threadIndex)
+        {
+            w_threads.emplace_back(w_loadGroups);
+        }
+        for (std::thread &w_thread : w_threads)
+        {
+            w_thread.join();
+        }
+    }
+
+    for (const std::string &w_error : w_errors)
+    {
+        if (!w_error.empty())
+        {
+            vtkOutputWindowDisplayErrorText(w_error.c_str());
+        }
     }
 }
 
@@ -1052,15 +1901,11 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addDataToParent(cons
 
     // search representation NodeId
     int w_nodeParent = _output->GetDataAssembly()->GetParent(p_nodeId);
-    uint32_t value_type;
-    _output->GetDataAssembly()->GetAttribute(w_nodeParent, "type", value_type);
-    TreeViewNodeType w_typeParent = static_cast<TreeViewNodeType>(value_type);
+    TreeViewNodeType w_typeParent = getNodeType(w_nodeParent);
     while (w_typeParent == TreeViewNodeType::Collection)
     {
         w_nodeParent = _output->GetDataAssembly()->GetParent(w_nodeParent);
-        value_type;
-        _output->GetDataAssembly()->GetAttribute(w_nodeParent, "type", value_type);
-        w_typeParent = static_cast<TreeViewNodeType>(value_type);
+        w_typeParent = getNodeType(w_nodeParent);
     }
 
     if (TreeViewNodeType::Perforation == p_type)
@@ -1096,7 +1941,7 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addDataToParent(cons
     {
         try
         {
-            COMMON_NS::AbstractObject* const w_result = _repository->getDataObjectByUuid(w_uuid);
+            COMMON_NS::AbstractObject* const w_result = resolvePartial(_repository->getDataObjectByUuid(w_uuid));
             if (static_cast<ResqmlWellboreFrameToVtkPartitionedDataSet*>(_nodeIdToMapperSet[w_nodeParent]))
             {
                 if (!_nodeIdToMapperSet[w_nodeParent]->existUuid(w_uuid))
@@ -1128,7 +1973,6 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addDataToParent(cons
                 resqml2::WellboreMarkerFrameRepresentation* w_markerFrame = _repository->getDataObjectByUuid<resqml2::WellboreMarkerFrameRepresentation>(w_uuidParent);
                 if (!_nodeIdToMapperSet[w_nodeParent]->existUuid(w_uuid))
                 {
-                    resqml2::WellboreMarker* const w_marker = _repository->getDataObjectByUuid<resqml2::WellboreMarker>(w_uuid);
                     (static_cast<ResqmlWellboreMarkerFrameToVtkPartitionedDataSet*>(_nodeIdToMapperSet[w_nodeParent]))->addMarker(w_markerFrame, w_uuid, _markerOrientation, _markerSize);
                 }
                 else
@@ -1155,8 +1999,9 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addDataToParent(cons
             {
                 ResqmlAbstractRepresentationToVtkPartitionedDataSet* abstractRepresentation = static_cast<ResqmlAbstractRepresentationToVtkPartitionedDataSet*>(_nodeIdToMapper[w_nodeParent]);
                 if (abstractRepresentation->getOutput()->GetNumberOfPartitions() == 0) {
-                    abstractRepresentation->loadVtkObject();
+                    abstractRepresentation->loadVtkObjectWithStatistics();
                 }
+                resolvePartial(_repository->getDataObjectByUuid(w_uuid));
                 abstractRepresentation->addDataArray(w_uuid);
             }
             else
@@ -1176,14 +2021,46 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addDataToParent(cons
             std::string w_tsUuid = w_uuid.substr(0, 36);
             std::string w_nodeName = w_uuid.substr(36);
 
-            auto const* assembly = _output->GetDataAssembly();
             if (_nodeIdToMapper[w_nodeParent])
             {
                 ResqmlAbstractRepresentationToVtkPartitionedDataSet* abstractRepresentation = static_cast<ResqmlAbstractRepresentationToVtkPartitionedDataSet*>(_nodeIdToMapper[w_nodeParent]);
                 if (abstractRepresentation->getOutput()->GetNumberOfPartitions() == 0) {
-                    abstractRepresentation->loadVtkObject();
+                    abstractRepresentation->loadVtkObjectWithStatistics();
+                }
+                const std::string w_propertyUuid = _timeSeriesUuidAndTitleToIndexAndPropertiesUuid[w_tsUuid][w_nodeName][p_time];
+                auto w_displayed = _timeSeriesNodeIdToPropertyUuid.find(p_nodeId);
+                if (w_displayed != _timeSeriesNodeIdToPropertyUuid.end() && w_displayed->second == w_propertyUuid)
+                {
+                    return;
+                }
+
+                resolvePartial(_repository->getDataObjectByUuid(w_propertyUuid));
+                ResqmlPropertyToVtkDataArray *w_dataArray = nullptr;
+                auto w_prefetched = _prefetchedDataArrays.find(w_propertyUuid);
+                if (w_prefetched != _prefetchedDataArrays.end())
+                {
+                    w_dataArray = w_prefetched->second;
+                    _prefetchedDataArrays.erase(w_prefetched);
+                }
+
+                // time change: the new time step is read into the array of the previous one
+                if (w_displayed == _timeSeriesNodeIdToPropertyUuid.end() ||
+                    !abstractRepresentation->replaceDataArray(w_displayed->second, w_propertyUuid, w_dataArray))
+                {
+                    if (w_displayed != _timeSeriesNodeIdToPropertyUuid.end())
+                    {
+                        abstractRepresentation->deleteDataArray(w_displayed->second);
+                    }
+                    if (w_dataArray != nullptr)
+                    {
+                        abstractRepresentation->addDataArray(w_propertyUuid, w_dataArray);
+                    }
+                    else
+                    {
+                        abstractRepresentation->addDataArray(w_propertyUuid);
+                    }
                 }
-                abstractRepresentation->addDataArray(_timeSeriesUuidAndTitleToIndexAndPropertiesUuid[w_tsUuid][w_nodeName][p_time]);
+                _timeSeriesNodeIdToPropertyUuid[p_nodeId] = w_propertyUuid;
             }
         }
         catch (const std::exception& e)
@@ -1197,7 +2074,7 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::addDataToParent(cons
 /**
  * delete oldSelection mapper
  */
-void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::deleteMapper(double p_time)
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::deleteMapper()
 {
     // initialization the output (VtkPartitionedDatasSetCollection) with same vtkDataAssembly
     vtkSmartPointer<vtkDataAssembly> w_Assembly = vtkSmartPointer<vtkDataAssembly>::New();
@@ -1209,36 +2086,39 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::deleteMapper(double
     for (const int w_nodeId : _oldSelection)
     {
         // retrieval of object type for nodeid
-        uint32_t w_valueType;
-        w_Assembly->GetAttribute(w_nodeId, "type", w_valueType);
-        TreeViewNodeType valueType = static_cast<TreeViewNodeType>(w_valueType);
+        TreeViewNodeType valueType = getNodeType(w_nodeId);
 
         // retrieval of object UUID for nodeId
         const std::string uuid_unselect = std::string(w_Assembly->GetNodeName(w_nodeId)).substr(1);
 
         if (valueType == TreeViewNodeType::TimeSeries)
-        { // TimeSerie properties deselection
-            std::string w_timeSeriesuuid = uuid_unselect.substr(0, 36);
-            std::string w_nodeName = uuid_unselect.substr(36);
-
-            const int w_nodeParent = w_Assembly->GetParent(w_Assembly->FindFirstNodeWithName(("_" + uuid_unselect).c_str()));
-            if (_nodeIdToMapper.find(w_nodeParent) != _nodeIdToMapper.end())
+        { // TimeSerie properties deselection: remove the time step which is displayed
+            auto w_displayed = _timeSeriesNodeIdToPropertyUuid.find(w_nodeId);
+            if (w_displayed != _timeSeriesNodeIdToPropertyUuid.end())
             {
-                static_cast<ResqmlAbstractRepresentationToVtkPartitionedDataSet*>(_nodeIdToMapper[w_nodeParent])->deleteDataArray(_timeSeriesUuidAndTitleToIndexAndPropertiesUuid[w_timeSeriesuuid][w_nodeName][p_time]);
+                const int w_nodeParent = w_Assembly->GetParent(w_nodeId);
+                try
+                {
+                    if (_nodeIdToMapper.find(w_nodeParent) != _nodeIdToMapper.end() && _nodeIdToMapper[w_nodeParent] != nullptr)
+                    {
+                        static_cast<ResqmlAbstractRepresentationToVtkPartitionedDataSet*>(_nodeIdToMapper[w_nodeParent])->deleteDataArray(w_displayed->second);
+                    }
+                }
+                catch (const std::exception &e)
+                {
+                    vtkOutputWindowDisplayErrorText(("Error in time series unload for uuid: " + uuid_unselect + "\n" + e.what()).c_str());
+                }
+                _timeSeriesNodeIdToPropertyUuid.erase(w_displayed);
             }
         }
         else if (valueType == TreeViewNodeType::Properties)
         {
             int w_nodeParent = _output->GetDataAssembly()->GetParent(w_nodeId);
-            uint32_t w_typeValue;
-            _output->GetDataAssembly()->GetAttribute(w_nodeParent, "type", w_typeValue);
-            TreeViewNodeType w_typeParent = static_cast<TreeViewNodeType>(w_typeValue);
+            TreeViewNodeType w_typeParent = getNodeType(w_nodeParent);
             while (w_typeParent == TreeViewNodeType::Collection)
             {
                 w_nodeParent = _output->GetDataAssembly()->GetParent(w_nodeParent);
-                w_typeValue;
-                _output->GetDataAssembly()->GetAttribute(w_nodeParent, "type", w_typeValue);
-                w_typeParent = static_cast<TreeViewNodeType>(w_typeValue);
+                w_typeParent = getNodeType(w_nodeParent);
             }
 
             try
@@ -1258,59 +2138,25 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::deleteMapper(double
         {
             const int w_nodeParent = w_Assembly->GetParent(w_nodeId);
             try
-            {
-                if (_nodeIdToMapperSet.find(w_nodeParent) != _nodeIdToMapperSet.end())
-                {
-                    _nodeIdToMapperSet[w_nodeParent]->removeCommonAbstractObjectToVtkPartitionedDataSet(std::string(w_Assembly->GetNodeName(w_nodeId)).substr(1));
-                }
-            }
-            catch (const std::exception &e)
-            {
-                vtkOutputWindowDisplayErrorText(("Error in property unload for uuid: " + uuid_unselect + "\n" + e.what()).c_str());
-            }
-        }
-        else if (valueType == TreeViewNodeType::SubRepresentation)
-        {
-            try
-            {
-                if (_nodeIdToMapper.find(w_nodeId) != _nodeIdToMapper.end())
-                {
-                    std::string uuid_supporting_grid = "";
-                    if (dynamic_cast<ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid *>(_nodeIdToMapper[w_nodeId]) != nullptr)
-                    {
-                        uuid_supporting_grid = static_cast<ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid *>(_nodeIdToMapper[w_nodeId])->unregisterToMapperSupportingGrid();
-                    }
-                    else if (dynamic_cast<ResqmlIjkGridSubRepToVtkExplicitStructuredGrid *>(_nodeIdToMapper[w_nodeId]) != nullptr)
-                    {
-                        uuid_supporting_grid = static_cast<ResqmlIjkGridSubRepToVtkExplicitStructuredGrid *>(_nodeIdToMapper[w_nodeId])->unregisterToMapperSupportingGrid();
-                    }
-                    delete _nodeIdToMapper[w_nodeId];
-                    _nodeIdToMapper.erase(w_nodeId);
-                }
-                else
+            {
+                if (_nodeIdToMapperSet.find(w_nodeParent) != _nodeIdToMapperSet.end())
                 {
-                    vtkOutputWindowDisplayErrorText(("Error in deselection for uuid: " + uuid_unselect + "\n").c_str());
+                    _nodeIdToMapperSet[w_nodeParent]->removeCommonAbstractObjectToVtkPartitionedDataSet(std::string(w_Assembly->GetNodeName(w_nodeId)).substr(1));
                 }
             }
             catch (const std::exception &e)
             {
-                vtkOutputWindowDisplayErrorText(("Error in subrepresentation unload for uuid: " + uuid_unselect + "\n" + e.what()).c_str());
+                vtkOutputWindowDisplayErrorText(("Error in property unload for uuid: " + uuid_unselect + "\n" + e.what()).c_str());
             }
         }
         else if (valueType == TreeViewNodeType::Representation ||
+                 valueType == TreeViewNodeType::SubRepresentation ||
                  valueType == TreeViewNodeType::WellboreTrajectory)
         {
-            try
-            {
-                if (_nodeIdToMapper.find(w_nodeId) != _nodeIdToMapper.end())
-                {
-                    delete _nodeIdToMapper[w_nodeId];
-                    _nodeIdToMapper.erase(w_nodeId);
-                }
-            }
-            catch (const std::exception &e)
+            // the mapper is kept for a later selection (see evictCachedMappers)
+            if (_nodeIdToMapper.find(w_nodeId) != _nodeIdToMapper.end() && _nodeIdToMapper[w_nodeId] != nullptr)
             {
-                vtkOutputWindowDisplayErrorText(("Error for unload uuid: " + uuid_unselect + "\n" + e.what()).c_str());
+                cacheMapper(w_nodeId);
             }
         }
         else if (valueType == TreeViewNodeType::Perforation)
@@ -1349,58 +2195,486 @@ void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::deleteMapper(double
             }
         }
     }
+    // the deselection has been processed
+    _oldSelection.clear();
+
+    evictCachedMappers();
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::deleteAllMappers()
+{
+    for (const auto &w_keyVal : _nodeIdToMapper)
+    {
+        delete w_keyVal.second;
+    }
+    _nodeIdToMapper.clear();
+    for (const auto &w_keyVal : _nodeIdToMapperSet)
+    {
+        delete w_keyVal.second;
+    }
+    _nodeIdToMapperSet.clear();
+    for (const auto &w_keyVal : _supportingIjkGridMappers)
+    {
+        delete w_keyVal.second.first;
+    }
+    _supportingIjkGridMappers.clear();
+    _cachedMappers.clear();
+    for (const auto &w_keyVal : _prefetchedDataArrays)
+    {
+        delete w_keyVal.second;
+    }
+    _prefetchedDataArrays.clear();
+    _timeSeriesNodeIdToPropertyUuid.clear();
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::setSinglePrecision(bool p_singlePrecision)
+{
+    stopBackgroundTask();
+    if (p_singlePrecision != _singlePrecision)
+    {
+        // the mappers keep the precision they have been loaded with
+        deleteAllMappers();
+        _singlePrecision = p_singlePrecision;
+    }
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::setGhostLevels(uint32_t p_ghostLevels)
+{
+    stopBackgroundTask();
+    if (p_ghostLevels != _ghostLevels)
+    {
+        // the blocks of the IJK grids are computed when their mapper is built
+        deleteAllMappers();
+        _ghostLevels = p_ghostLevels;
+    }
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::setStride(uint32_t p_stride)
+{
+    stopBackgroundTask();
+    if (p_stride != _stride)
+    {
+        // the full resolution is only reloaded on request
+        deleteAllMappers();
+        _stride = p_stride;
+    }
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::setSurfaceOnly(bool p_surfaceOnly)
+{
+    stopBackgroundTask();
+    if (p_surfaceOnly != _surfaceOnly)
+    {
+        deleteAllMappers();
+        _surfaceOnly = p_surfaceOnly;
+    }
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::setCacheSize(uint32_t p_cacheSizeMB)
+{
+    stopBackgroundTask();
+    _cacheSizeMB = p_cacheSizeMB;
+    evictCachedMappers();
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::cacheMapper(int p_nodeId)
+{
+    const auto w_it = _nodeIdToMapper.find(p_nodeId);
+    if (w_it == _nodeIdToMapper.end() || w_it->second == nullptr)
+    {
+        return;
+    }
+    CommonAbstractObjectToVtkPartitionedDataSet *w_mapper = w_it->second;
+    vtkPartitionedDataSet *w_output = w_mapper->getOutput();
+    unsigned long w_memorySize = w_output == nullptr ? 0 : w_output->GetActualMemorySize();
+    // the points of a subrepresentation are shared with (and accounted by) the mapper of its supporting grid (see getCachedMappersMemorySize)
+    if (w_output != nullptr &&
+        (dynamic_cast<ResqmlIjkGridSubRepToVtkExplicitStructuredGrid *>(w_mapper) != nullptr ||
+         dynamic_cast<ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid *>(w_mapper) != nullptr))
+    {
+        for (unsigned int w_partitionIndex = 0; w_partitionIndex < w_output->GetNumberOfPartitions(); ++w_partitionIndex)
+        {
+            vtkPointSet *w_pointSet = vtkPointSet::SafeDownCast(w_output->GetPartition(w_partitionIndex));
+            if (w_pointSet != nullptr && w_pointSet->GetPoints() != nullptr)
+            {
+                w_memorySize -= (std::min)(w_memorySize, w_pointSet->GetPoints()->GetActualMemorySize());
+            }
+        }
+    }
+
+    _cachedMappers.remove_if([p_nodeId](const std::pair<int, unsigned long> &p_cachedMapper)
+                             { return p_cachedMapper.first == p_nodeId; });
+    _cachedMappers.emplace_front(p_nodeId, w_memorySize);
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::evictCachedMappers()
+{
+    const unsigned long w_budget = static_cast<unsigned long>(_cacheSizeMB) * 1024;
+    unsigned long w_cacheSize = getCachedMappersMemorySize();
+
+    // deleting a subrepresentation may release its supporting grid: loop until nothing more can be evicted
+    bool w_evicted = true;
+    while (w_evicted && !_cachedMappers.empty() && (w_cacheSize > w_budget || w_budget == 0))
+    {
+        w_evicted = false;
+        auto w_it = _cachedMappers.end();
+        while (w_it != _cachedMappers.begin() && (w_cacheSize > w_budget || w_budget == 0))
+        {
+            --w_it;
+            // a supporting grid cannot be deleted while a subrepresentation uses its points
+            const auto w_mapper = _nodeIdToMapper.find(w_it->first);
+            auto const *w_representationMapper = w_mapper == _nodeIdToMapper.end() ? nullptr : dynamic_cast<ResqmlAbstractRepresentationToVtkPartitionedDataSet *>(w_mapper->second);
+            if (w_representationMapper != nullptr && w_representationMapper->subRepLinkedCount() > 0)
+            {
+                continue;
+            }
+            const int w_nodeId = w_it->first;
+            w_it = _cachedMappers.erase(w_it);
+            deleteNodeMapper(w_nodeId);
+            // the deletion may also release the whole grid mapper of IJK subrepresentations or cache a supporting grid
+            w_cacheSize = getCachedMappersMemorySize();
+            w_evicted = true;
+        }
+    }
+}
+
+unsigned long ResqmlDataRepositoryToVtkPartitionedDataSetCollection::getCachedMappersMemorySize() const
+{
+    unsigned long w_cacheSize = 0;
+    std::unordered_map<std::string, uint32_t> w_cachedSubRepCounts;
+    for (const auto &w_cachedMapper : _cachedMappers)
+    {
+        w_cacheSize += w_cachedMapper.second;
+        const auto w_mapper = _nodeIdToMapper.find(w_cachedMapper.first);
+        auto const *w_subRepMapper = w_mapper == _nodeIdToMapper.end() ? nullptr : dynamic_cast<ResqmlIjkGridSubRepToVtkExplicitStructuredGrid *>(w_mapper->second);
+        if (w_subRepMapper != nullptr)
+        {
+            ++w_cachedSubRepCounts[w_subRepMapper->getSupportingGridUuid()];
+        }
+    }
+
+    // the points of the whole grid are only kept for cached subrepresentations: a selected one still displays them
+    for (const auto &w_cachedSubRepCount : w_cachedSubRepCounts)
+    {
+        const auto w_supportingIjkGridMapper = _supportingIjkGridMappers.find(w_cachedSubRepCount.first);
+        if (w_supportingIjkGridMapper != _supportingIjkGridMappers.end() && w_supportingIjkGridMapper->second.second == w_cachedSubRepCount.second)
+        {
+            w_cacheSize += w_supportingIjkGridMapper->second.first->getPointsMemorySize();
+        }
+    }
+    return w_cacheSize;
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::deleteNodeMapper(int p_nodeId)
+{
+    auto w_it = _nodeIdToMapper.find(p_nodeId);
+    if (w_it == _nodeIdToMapper.end())
+    {
+        return;
+    }
+
+    std::string w_supportingGridUuid;
+    try
+    {
+        if (dynamic_cast<ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid *>(w_it->second) != nullptr)
+        {
+            w_supportingGridUuid = static_cast<ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid *>(w_it->second)->unregisterToMapperSupportingGrid();
+        }
+        else if (dynamic_cast<ResqmlIjkGridSubRepToVtkExplicitStructuredGrid *>(w_it->second) != nullptr)
+        {
+            w_supportingGridUuid = static_cast<ResqmlIjkGridSubRepToVtkExplicitStructuredGrid *>(w_it->second)->unregisterToMapperSupportingGrid();
+        }
+    }
+    catch (const std::exception &e)
+    {
+        vtkOutputWindowDisplayErrorText(("Error in subrepresentation unload for uuid: " + w_it->second->getUuid() + "\n" + e.what()).c_str());
+    }
+    delete w_it->second;
+    _nodeIdToMapper.erase(w_it);
+
+    // the whole grid mapper of the IJK subrepresentations is deleted with the last of them
+    auto w_supportingIjkGridMapper = _supportingIjkGridMappers.find(w_supportingGridUuid);
+    if (w_supportingIjkGridMapper != _supportingIjkGridMappers.end() && --w_supportingIjkGridMapper->second.second == 0)
+    {
+        delete w_supportingIjkGridMapper->second.first;
+        _supportingIjkGridMappers.erase(w_supportingIjkGridMapper);
+    }
+
+    // the time steps displayed by the deleted mapper
+    for (auto w_displayed = _timeSeriesNodeIdToPropertyUuid.begin(); w_displayed != _timeSeriesNodeIdToPropertyUuid.end();)
+    {
+        if (GetAssembly()->GetParent(w_displayed->first) == p_nodeId)
+        {
+            w_displayed = _timeSeriesNodeIdToPropertyUuid.erase(w_displayed);
+        }
+        else
+        {
+            ++w_displayed;
+        }
+    }
+
+    // the mapper of an unselected supporting grid can now be evicted too
+    if (!w_supportingGridUuid.empty())
+    {
+        const int w_supportingGridNodeId = findNode("_" + w_supportingGridUuid);
+        if (_nodeIdToMapper.find(w_supportingGridNodeId) != _nodeIdToMapper.end() &&
+            _currentSelection.find(w_supportingGridNodeId) == _currentSelection.end() &&
+            std::find_if(_cachedMappers.begin(), _cachedMappers.end(), [w_supportingGridNodeId](const std::pair<int, unsigned long> &p_cachedMapper)
+                         { return p_cachedMapper.first == w_supportingGridNodeId; }) == _cachedMappers.end())
+        {
+            cacheMapper(w_supportingGridNodeId);
+        }
+    }
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::startBackgroundTask(double p_time)
+{
+    stopBackgroundTask();
+
+    // the properties of the next time steps of each selected time series
+    std::vector<std::pair<ResqmlAbstractRepresentationToVtkPartitionedDataSet *, std::string>> w_propertiesToRead;
+    std::set<std::string> w_prefetchedUuids;
+    for (const int w_nodeId : _currentSelection)
+    {
+        if (_numberOfPrefetchedTimeSteps == 0 || getNodeType(w_nodeId) != TreeViewNodeType::TimeSeries)
+        {
+            continue;
+        }
+        // the values are read with the dimensions of a representation already loaded
+        auto w_mapper = _nodeIdToMapper.find(GetAssembly()->GetParent(w_nodeId));
+        if (w_mapper == _nodeIdToMapper.end() || w_mapper->second == nullptr || w_mapper->second->getOutput()->GetNumberOfPartitions() == 0)
+        {
+            continue;
+        }
+        const std::string w_name = std::string(GetAssembly()->GetNodeName(w_nodeId)).substr(1);
+        auto w_timeSeries = _timeSeriesUuidAndTitleToIndexAndPropertiesUuid.find(w_name.substr(0, 36));
+        if (w_timeSeries == _timeSeriesUuidAndTitleToIndexAndPropertiesUuid.end())
+        {
+            continue;
+        }
+        auto w_timeSteps = w_timeSeries->second.find(w_name.substr(36));
+        if (w_timeSteps == w_timeSeries->second.end())
+        {
+            continue;
+        }
+        auto w_timeStep = w_timeSteps->second.upper_bound(p_time);
+        for (uint32_t w_index = 0; w_index < _numberOfPrefetchedTimeSteps && w_timeStep != w_timeSteps->second.end(); ++w_index, ++w_timeStep)
+        {
+            w_prefetchedUuids.insert(w_timeStep->second);
+            if (_prefetchedDataArrays.find(w_timeStep->second) == _prefetchedDataArrays.end())
+            {
+                w_propertiesToRead.emplace_back(static_cast<ResqmlAbstractRepresentationToVtkPartitionedDataSet *>(w_mapper->second), w_timeStep->second);
+            }
+        }
+    }
+
+    // the cache only keeps the time steps following p_time
+    for (auto w_it = _prefetchedDataArrays.begin(); w_it != _prefetchedDataArrays.end();)
+    {
+        if (w_prefetchedUuids.find(w_it->first) == w_prefetchedUuids.end())
+        {
+            delete w_it->second;
+            w_it = _prefetchedDataArrays.erase(w_it);
+        }
+        else
+        {
+            ++w_it;
+        }
+    }
+
+    // no other method touches fesapi or the mappers until stopBackgroundTask has been called
+    _stopBackgroundTask = false;
+    auto w_backgroundTask = [this, w_propertiesToRead]() -> void
+    {
+        {
+            CommonAbstractObjectToVtkPartitionedDataSet::FesapiLock w_fesapiLock;
+            for (const auto &w_property : w_propertiesToRead)
+            {
+                if (_stopBackgroundTask)
+                {
+                    break;
+                }
+                try
+                {
+                    resolvePartial(_repository->getDataObjectByUuid(w_property.second));
+                    _prefetchedDataArrays[w_property.second] = w_property.first->createDataArray(w_property.second);
+                }
+                catch (const std::exception &)
+                {
+                    // read again (and reported) when this time step is displayed
+                }
+            }
+            recordHdfFileStates();
+        }
+
+        // the HDF5 files are closed if they are not used again before the idle timeout
+        std::unique_lock<std::mutex> w_lock(_backgroundTaskMutex);
+        if (!_backgroundTaskCondition.wait_for(w_lock, std::chrono::seconds(_hdfIdleTimeout), [this]() -> bool
+                                               { return _stopBackgroundTask; }))
+        {
+            CommonAbstractObjectToVtkPartitionedDataSet::FesapiLock w_fesapiLock;
+            for (EML2_NS::AbstractHdfProxy *w_proxy : _repository->getDataObjects<EML2_NS::AbstractHdfProxy>())
+            {
+                w_proxy->close();
+            }
+            _hdfFileStates.clear();
+        }
+    };
+    _backgroundTask = std::async(std::launch::async, w_backgroundTask);
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::stopBackgroundTask()
+{
+    if (_backgroundTask.valid())
+    {
+        {
+            std::lock_guard<std::mutex> w_lock(_backgroundTaskMutex);
+            _stopBackgroundTask = true;
+        }
+        _backgroundTaskCondition.notify_all();
+        _backgroundTask.wait();
+        _backgroundTask = std::future<void>();
+    }
+}
+
+std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::getHdfFileState(EML2_NS::AbstractHdfProxy const *p_hdfProxy) const
+{
+    // the path of an HDF proxy is relative to the directory of its EPC document
+    std::string w_path = p_hdfProxy->getRelativePath();
+    if (!w_path.empty() && !vtksys::SystemTools::FileIsFullPath(w_path))
+    {
+        const std::string w_relativePath = w_path;
+        w_path.clear();
+        for (const std::string &w_fileName : _files)
+        {
+            const std::string w_candidate = vtksys::SystemTools::CollapseFullPath(w_relativePath, vtksys::SystemTools::GetFilenamePath(w_fileName));
+            if (vtksys::SystemTools::FileExists(w_candidate, true))
+            {
+                w_path = w_candidate;
+                break;
+            }
+        }
+    }
+
+    vtksys::SystemTools::Stat_t w_stat;
+    if (w_path.empty() || vtksys::SystemTools::Stat(w_path, &w_stat) != 0)
+    {
+        return "";
+    }
+    return std::to_string(w_stat.st_size) + ' ' + std::to_string(w_stat.st_mtime) + ' ' + std::to_string(w_stat.st_ino);
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::closeModifiedHdfProxies()
+{
+    for (EML2_NS::AbstractHdfProxy *w_proxy : _repository->getDataObjects<EML2_NS::AbstractHdfProxy>())
+    {
+        auto w_state = _hdfFileStates.find(w_proxy->getUuid());
+        if (w_state != _hdfFileStates.end() && w_proxy->isOpened() && getHdfFileState(w_proxy) != w_state->second)
+        {
+            // reopened (with its new content) when it is read again
+            w_proxy->close();
+            _hdfFileStates.erase(w_state);
+            _ijkGridHyperslabingCapacities.clear();
+        }
+    }
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::recordHdfFileStates()
+{
+    for (EML2_NS::AbstractHdfProxy *w_proxy : _repository->getDataObjects<EML2_NS::AbstractHdfProxy>())
+    {
+        if (w_proxy->isOpened())
+        {
+            _hdfFileStates[w_proxy->getUuid()] = getHdfFileState(w_proxy);
+        }
+    }
 }
 
 vtkPartitionedDataSetCollection *ResqmlDataRepositoryToVtkPartitionedDataSetCollection::getVtkPartitionedDatasSetCollection(const double p_time, const uint32_t p_nbProcess, const uint32_t p_processId)
 {
-    deleteMapper(p_time);
+    stopBackgroundTask();
+    _updatePhaseTimes.clear();
+    auto w_tPhaseStart = std::chrono::high_resolution_clock::now();
+    const auto w_endPhase = [this, &w_tPhaseStart](const char *p_phase)
+    {
+        const auto w_tPhaseEnd = std::chrono::high_resolution_clock::now();
+        _updatePhaseTimes.emplace_back(p_phase, std::chrono::duration<double, std::milli>(w_tPhaseEnd - w_tPhaseStart).count());
+        w_tPhaseStart = w_tPhaseEnd;
+    };
+
+    closeModifiedHdfProxies();
+
+    // the mappers only hold the data of the piece they have been built for
+    if (p_nbProcess != _nbProcess || p_processId != _processId)
+    {
+        deleteAllMappers();
+        _nbProcess = p_nbProcess;
+        _processId = p_processId;
+    }
+
+    deleteMapper();
+    w_endPhase("deselection");
 
     // vtkParitionedDataSetCollection - hierarchy - build
     // foreach selection node init object
-    auto w_it = _currentSelection.begin();
-    while (w_it != _currentSelection.end())
+    std::map<int, std::vector<int>> w_loadingGroups;
+    for (const int w_nodeId : _currentSelection)
     {
-        uint32_t w_typeValue;
-        _output->GetDataAssembly()->GetAttribute(*w_it, "type", w_typeValue);
-        TreeViewNodeType w_type = static_cast<TreeViewNodeType>(w_typeValue);
+        TreeViewNodeType w_type = getNodeType(w_nodeId);
 
         // init MapperSet && save nodeId for attach to vtkPartitionedDataSetcollection
         if (getMapperType(w_type) == MapperType::MapperSet)
         {
             // initialize mapperSet with nodeId
-            if (_nodeIdToMapperSet.find(*w_it) == _nodeIdToMapperSet.end())
+            if (_nodeIdToMapperSet.find(w_nodeId) == _nodeIdToMapperSet.end())
             {
-                initMapperSet(w_type, *w_it, p_nbProcess, p_processId);
+                initMapperSet(w_type, w_nodeId, p_nbProcess, p_processId);
             }
-            ++w_it;
         }
         else if (getMapperType(w_type) == MapperType::Mapper)
         {
-            // load mapper with nodeId
-            if (_nodeIdToMapper.find(*w_it) == _nodeIdToMapper.end())
+            // init mapper with nodeId
+            if (_nodeIdToMapper.find(w_nodeId) == _nodeIdToMapper.end() || _nodeIdToMapper[w_nodeId] == nullptr)
             {
-                loadMapper(w_type, *w_it, p_nbProcess, p_processId);
+                const int w_loadingGroup = loadMapper(w_type, w_nodeId, p_nbProcess, p_processId);
+                if (_nodeIdToMapper.find(w_nodeId) != _nodeIdToMapper.end() && _nodeIdToMapper[w_nodeId] != nullptr)
+                {
+                    w_loadingGroups[w_loadingGroup].push_back(w_nodeId);
+                }
+            }
+            else
+            {
+                // selected again: the mapper leaves the cache
+                _cachedMappers.remove_if([w_nodeId](const std::pair<int, unsigned long> &p_cachedMapper)
+                                         { return p_cachedMapper.first == w_nodeId; });
+                // e.g. a supporting grid whose mapper has only been created for its subrepresentations
+                if (_nodeIdToMapper[w_nodeId]->getOutput()->GetNumberOfPartitions() == 0)
+                {
+                    w_loadingGroups[w_nodeId].push_back(w_nodeId);
+                }
             }
-            ++w_it;
-        }
-        else if (getMapperType(w_type) == MapperType::Folder)
-        {
-            ++w_it;
         }
-        else if (getMapperType(w_type) == MapperType::Data)
+    }
+
+    // load the new mappers (in parallel) before adding their data
+    loadMappers(w_loadingGroups);
+    w_endPhase("mapperLoad");
+
+    for (const int w_nodeId : _currentSelection)
+    {
+        TreeViewNodeType w_type = getNodeType(w_nodeId);
+        if (getMapperType(w_type) == MapperType::Data)
         {
-            addDataToParent(w_type, *w_it, p_nbProcess, p_processId, p_time);
-            ++w_it;
+            addDataToParent(w_type, w_nodeId, p_nbProcess, p_processId, p_time);
         }
     }
+    w_endPhase("propertyLoad");
 
     unsigned int w_PartitionIndex = 0;
     // foreach selection node load object
     for (const int w_nodeSelection : _currentSelection)
     {
-        uint32_t w_typeValue;
-        _output->GetDataAssembly()->GetAttribute(w_nodeSelection, "type", w_typeValue);
-        TreeViewNodeType w_type = static_cast<TreeViewNodeType>(w_typeValue);
+        TreeViewNodeType w_type = getNodeType(w_nodeSelection);
 
         if (getMapperType(w_type) == MapperType::MapperSet)
         {
@@ -1417,6 +2691,7 @@ vtkPartitionedDataSetCollection *ResqmlDataRepositoryToVtkPartitionedDataSetColl
                     }
                 for (auto partition : _nodeIdToMapperSet[w_nodeSelection]->getMapperSet())
                 {
+                    partition->addLoadingStatisticsToOutput();
                     _output->SetPartitionedDataSet(w_PartitionIndex, partition->getOutput());
                     _output->GetMetaData(w_PartitionIndex)->Set(vtkCompositeDataSet::NAME(), partition->getTitle() + '(' + partition->getUuid() + ')');
                     GetAssembly()->AddDataSetIndex(w_nodeSelection, w_PartitionIndex); // attach hierarchy to assembly
@@ -1429,6 +2704,7 @@ vtkPartitionedDataSetCollection *ResqmlDataRepositoryToVtkPartitionedDataSetColl
             // load mapper representation
             if (_nodeIdToMapper.find(w_nodeSelection) != _nodeIdToMapper.end())
             {
+                _nodeIdToMapper[w_nodeSelection]->addLoadingStatisticsToOutput();
                 _output->SetPartitionedDataSet(w_PartitionIndex, _nodeIdToMapper[w_nodeSelection]->getOutput());
                 _output->GetMetaData(w_PartitionIndex)->Set(vtkCompositeDataSet::NAME(), _nodeIdToMapper[w_nodeSelection]->getTitle() + '(' + _nodeIdToMapper[w_nodeSelection]->getUuid() + ')');
                 GetAssembly()->AddDataSetIndex(w_nodeSelection, w_PartitionIndex); // attach hierarchy to assembly
@@ -1438,9 +2714,114 @@ vtkPartitionedDataSetCollection *ResqmlDataRepositoryToVtkPartitionedDataSetColl
     }
 
     _output->Modified();
+    w_endPhase("outputAssembly");
     return _output;
 }
 
+std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::getPhaseTimes() const
+{
+    const auto w_writePhases = [](std::ostringstream &p_json, const std::vector<std::pair<std::string, double>> &p_phaseTimes)
+    {
+        p_json << '{';
+        for (size_t w_index = 0; w_index < p_phaseTimes.size(); ++w_index)
+        {
+            p_json << (w_index == 0 ? "" : ", ") << '"' << p_phaseTimes[w_index].first << "\": " << p_phaseTimes[w_index].second;
+        }
+        p_json << '}';
+    };
+
+    std::ostringstream w_json;
+    w_json << std::fixed << std::setprecision(3) << "{\"files\": ";
+    w_writePhases(w_json, _filePhaseTimes);
+    w_json << ", \"update\": ";
+    w_writePhases(w_json, _updatePhaseTimes);
+    w_json << '}';
+    return w_json.str();
+}
+
+std::string ResqmlDataRepositoryToVtkPartitionedDataSetCollection::getLoadingStatistics() const
+{
+    std::vector<const CommonAbstractObjectToVtkPartitionedDataSet *> w_mappers;
+    for (const auto &w_keyVal : _nodeIdToMapper)
+    {
+        if (w_keyVal.second != nullptr)
+        {
+            w_mappers.push_back(w_keyVal.second);
+        }
+    }
+    for (const auto &w_keyVal : _nodeIdToMapperSet)
+    {
+        for (const CommonAbstractObjectToVtkPartitionedDataSet *w_mapper : w_keyVal.second->getMapperSet())
+        {
+            w_mappers.push_back(w_mapper);
+        }
+    }
+
+    // the slowest objects first
+    std::sort(w_mappers.begin(), w_mappers.end(), [](const CommonAbstractObjectToVtkPartitionedDataSet *p_first, const CommonAbstractObjectToVtkPartitionedDataSet *p_second) -> bool
+              { return p_first->getLoadingStatistics().loadTime + p_first->getLoadingStatistics().propertiesTime >
+                       p_second->getLoadingStatistics().loadTime + p_second->getLoadingStatistics().propertiesTime; });
+
+    CommonAbstractObjectToVtkPartitionedDataSet::LoadingStatistics w_total;
+    std::ostringstream w_details;
+    w_details << std::fixed << std::setprecision(1);
+    for (const CommonAbstractObjectToVtkPartitionedDataSet *w_mapper : w_mappers)
+    {
+        const CommonAbstractObjectToVtkPartitionedDataSet::LoadingStatistics &w_statistics = w_mapper->getLoadingStatistics();
+        w_total.loadTime += w_statistics.loadTime;
+        w_total.pointsTime += w_statistics.pointsTime;
+        w_total.propertiesTime += w_statistics.propertiesTime;
+        w_total.bytesRead += w_statistics.bytesRead;
+        w_total.valuesConverted += w_statistics.valuesConverted;
+        w_total.peakBytes = (std::max)(w_total.peakBytes, w_statistics.peakBytes);
+        w_details << w_mapper->getTitle() << " (" << w_mapper->getUuid() << "): load " << w_statistics.loadTime << "ms (points " << w_statistics.pointsTime
+                  << "ms), properties " << w_statistics.propertiesTime << "ms, " << w_statistics.bytesRead / 1048576.0 << "MB read, "
+                  << w_statistics.valuesConverted << " values, peak " << w_statistics.peakBytes / 1048576.0 << "MB\n";
+    }
+
+    std::ostringstream w_summary;
+    w_summary << std::fixed << std::setprecision(1) << w_mappers.size() << " object(s): load " << w_total.loadTime << "ms (points " << w_total.pointsTime
+              << "ms), properties " << w_total.propertiesTime << "ms, " << w_total.bytesRead / 1048576.0 << "MB read, "
+              << w_total.valuesConverted << " values, largest peak " << w_total.peakBytes / 1048576.0 << "MB\n";
+    return w_summary.str() + w_details.str();
+}
+
+void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::shallowCopy(vtkPartitionedDataSetCollection *p_source, vtkPartitionedDataSetCollection *p_destination)
+{
+    p_destination->ShallowCopy(p_source);
+
+    // ShallowCopy shares the data assembly which the repository modifies in place when the tree changes:
+    // the pipeline gets its own copy
+    if (p_source->GetDataAssembly() != nullptr)
+    {
+        vtkSmartPointer<vtkDataAssembly> w_assembly = vtkSmartPointer<vtkDataAssembly>::New();
+        w_assembly->DeepCopy(p_source->GetDataAssembly());
+        p_destination->SetDataAssembly(w_assembly);
+    }
+
+    // Depending on the VTK version, ShallowCopy either shares the leaf datasets or creates new ones.
+    // Always give the pipeline its own leaf instances: they still share the mapper arrays.
+    for (unsigned int w_pdsIndex = 0; w_pdsIndex < p_destination->GetNumberOfPartitionedDataSets(); ++w_pdsIndex)
+    {
+        vtkPartitionedDataSet *w_destinationPds = p_destination->GetPartitionedDataSet(w_pdsIndex);
+        vtkPartitionedDataSet *w_sourcePds = p_source->GetPartitionedDataSet(w_pdsIndex);
+        if (w_destinationPds == nullptr || w_sourcePds == nullptr)
+        {
+            continue;
+        }
+        for (unsigned int w_partitionIndex = 0; w_partitionIndex < w_destinationPds->GetNumberOfPartitions(); ++w_partitionIndex)
+        {
+            vtkDataObject *w_partition = w_destinationPds->GetPartitionAsDataObject(w_partitionIndex);
+            if (w_partition != nullptr && w_partition == w_sourcePds->GetPartitionAsDataObject(w_partitionIndex))
+            {
+                vtkSmartPointer<vtkDataObject> w_copy = vtkSmartPointer<vtkDataObject>::Take(w_partition->NewInstance());
+                w_copy->ShallowCopy(w_partition);
+                w_destinationPds->SetPartition(w_partitionIndex, w_copy);
+            }
+        }
+    }
+}
+
 void ResqmlDataRepositoryToVtkPartitionedDataSetCollection::setMarkerOrientation(bool orientation)
 {
     _markerOrientation = orientation;
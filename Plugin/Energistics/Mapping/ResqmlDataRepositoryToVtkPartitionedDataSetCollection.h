@@ -20,9 +20,16 @@ under the License.
 #define __ResqmlDataRepositoryToVtkPartitionedDataSetCollection_h
 
 // include system
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
 #include <string>
+#include <list>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 #include <vtkSmartPointer.h>
 #include <vtkPartitionedDataSetCollection.h>
@@ -36,7 +43,14 @@ under the License.
 
 namespace common
 {
+	class AbstractObject;
 	class DataObjectRepository;
+	class EpcDocument;
+}
+
+namespace eml2
+{
+	class AbstractHdfProxy;
 }
 
 namespace resqml2
@@ -55,8 +69,10 @@ namespace resqml2_0_1
 }
 
 class ResqmlAbstractRepresentationToVtkPartitionedDataSet;
+class ResqmlIjkGridToVtkExplicitStructuredGrid;
 class CommonAbstractObjectSetToVtkPartitionedDataSetSet;
 class CommonAbstractObjectToVtkPartitionedDataSet;
+class ResqmlPropertyToVtkDataArray;
 
 /**
  * @brief	transform a fesapi data repository to VtkPartitionedDataSetCollection
@@ -73,8 +89,98 @@ public:
 
 	// for EPC reader
 	std::string addFile(const char *p_file);
+	/**
+	 * deserialize all the files (concurrently) before building the tree once
+	 */
+	std::string addFiles(const std::vector<std::string> &p_files);
+	/**
+	 * @return the reading and merging time of each file and the tree building time of the last addFile(s) call
+	 */
+	std::string getLoadingTimes() const { return _loadingTimes; }
+	/**
+	 * @return the duration (ms) of each phase of the last addFile(s) call and of the last update as a JSON object
+	 * (e.g. to be compared between releases by a pvpython script)
+	 */
+	std::string getPhaseTimes() const;
+	/**
+	 * @return the duration (ms) of each phase of the last addFile(s) call, in their order
+	 */
+	const std::vector<std::pair<std::string, double>> &getFilePhaseTimes() const { return _filePhaseTimes; }
+	/**
+	 * @return the duration (ms) of each phase of the last update, in their order
+	 */
+	const std::vector<std::pair<std::string, double>> &getUpdatePhaseTimes() const { return _updatePhaseTimes; }
+	/**
+	 * @return the loading statistics of all the objects (total then each object, the slowest first)
+	 */
+	std::string getLoadingStatistics() const;
 	// for EPC reader
+	/**
+	 * close the HDF5 files now (e.g. to let another tool write them)
+	 */
 	void closeHdfProxies();
+	/**
+	 * The HDF5 files are kept open between two updates and closed once they have not been used for p_seconds
+	 * (0 closes them after each update). A file modified on disk is reopened before being read again.
+	 */
+	void setHdfIdleTimeout(uint32_t p_seconds) { _hdfIdleTimeout = p_seconds; }
+	/**
+	 * In lazy loading mode, the files added afterwards are only partially deserialized (content types and relationships):
+	 * the xml of a data object is deserialized when it is loaded for the first time.
+	 */
+	void setLazyLoading(bool p_lazyLoading) { _lazyLoading = p_lazyLoading; }
+	/**
+	 * When the first files are loaded, the tree and the time steps are read from a cache file of the user cache directory
+	 * (e.g. ~/.cache/fespp) if the size, modification time and inode of the files have not changed since the cache was written.
+	 * @param p_writeCache	false if the cache must only be read (e.g. not the first process)
+	 */
+	void setUseCache(bool p_useCache, bool p_writeCache = true)
+	{
+		_useCache = p_useCache;
+		_writeCache = p_writeCache;
+	}
+
+	/**
+	 * Number of threads used to load the selected representations (0 means one per core).
+	 * The representations sharing the same supporting grid are loaded by the same thread.
+	 */
+	void setNumberOfThreads(uint32_t p_numberOfThreads) { _numberOfThreads = p_numberOfThreads; }
+	/**
+	 * Memory budget of the mappers kept after their deselection, which are reused if they are selected again.
+	 * 0 deletes the mappers as soon as they are deselected.
+	 */
+	void setCacheSize(uint32_t p_cacheSizeMB);
+	/**
+	 * Number of time steps following the displayed one whose properties are read in background (0 disables the prefetch).
+	 */
+	void setNumberOfPrefetchedTimeSteps(uint32_t p_numberOfTimeSteps) { _numberOfPrefetchedTimeSteps = p_numberOfTimeSteps; }
+	/**
+	 * Store the geometry of the grids and surfaces as float relative to a local origin of each dataset (its "LocalOrigin" field data)
+	 * and the continuous properties as float. The loaded mappers are rebuilt when the mode changes.
+	 */
+	void setSinglePrecision(bool p_singlePrecision);
+	/**
+	 * Number of cell layers read around the block of an IJK grid loaded by each process (marked as duplicate ghost cells).
+	 * The loaded mappers are rebuilt when the number changes.
+	 */
+	void setGhostLevels(uint32_t p_ghostLevels);
+	/**
+	 * Load the IJK grids as a coarsened preview made of a cell every p_stride cells along each axis (1 for the full resolution).
+	 * The loaded mappers are rebuilt when the stride changes.
+	 */
+	void setStride(uint32_t p_stride);
+	/**
+	 * Load only the boundary faces of the IJK grids as vtkPolyData. The loaded mappers are rebuilt when the mode changes.
+	 */
+	void setSurfaceOnly(bool p_surfaceOnly);
+	/**
+	 * Start to read in background the properties of the selected time series for the time steps following p_time
+	 * (they are added without any HDF5 reading when these time steps are displayed), then close the HDF5 files
+	 * after the idle timeout.
+	 * Call it once the output has been given to the pipeline: the next call to any other method waits for the end
+	 * of the current reading and keeps the HDF5 files open.
+	 */
+	void startBackgroundTask(double p_time);
 
 	// for ETP source
 	std::string addDataspace(const char *p_dataspace);
@@ -89,6 +195,14 @@ public:
 
 	vtkPartitionedDataSetCollection *getVtkPartitionedDatasSetCollection(const double p_time, const uint32_t p_nbProcess = 1, const uint32_t p_processId = 0);
 
+	/**
+	 * Copy p_source into p_destination without duplicating the arrays (points, cells, properties) owned by the mappers.
+	 * Each partition of p_destination is a new dataset instance so that the mappers can later add or remove
+	 * arrays on their own datasets without altering what has already been given to the pipeline.
+	 * The data assembly, which is small, is deep copied for the same reason.
+	 */
+	static void shallowCopy(vtkPartitionedDataSetCollection *p_source, vtkPartitionedDataSetCollection *p_destination);
+
 	std::vector<double> getTimes() { return _timesStep; };
 
 	/**
@@ -98,36 +212,113 @@ public:
 	void clearSelection();
 
 private:
-	std::string buildDataAssemblyFromDataObjectRepo(const char *p_fileName);
+	std::string deserializeFile(const char *p_fileName, bool p_partially);
+	/**
+	 * deserialize the files into the repository: except in lazy loading, each file is opened once and read by
+	 * concurrent threads (one repository per file), then all of them are merged by the calling thread.
+	 * The repository is not modified if one of the files cannot be read.
+	 */
+	std::string deserializeFiles(const std::vector<std::string> &p_fileNames);
+
+	/**
+	 * @return the cache key of the files: full path, size, modification time, inode and md5 of the first and last 64KB of each file.
+	 * Empty if a file cannot be read.
+	 */
+	std::string computeCacheKey(const std::vector<std::string> &p_fileNames) const;
+	/**
+	 * load the files (partially in lazy loading) and restore the tree and time steps from the cache
+	 * @return false if the cache does not exist or is stale (nothing has been loaded)
+	 */
+	bool loadCache(const std::vector<std::string> &p_fileNames, const std::string &p_cacheKey, std::string &p_message);
+	void saveCache(const std::vector<std::string> &p_fileNames, const std::string &p_cacheKey) const;
+	/**
+	 * @return the uuids of the data objects added since p_uuidsBefore and of their direct targets,
+	 * i.e. the data objects whose tree must be updated
+	 */
+	std::set<std::string> getUpdatedUuids(const std::vector<std::string> &p_uuidsBefore) const;
+	/**
+	 * add the p_updatedUuids data objects to the tree (the other ones are already in the tree)
+	 */
+	std::string buildDataAssemblyFromDataObjectRepo(const char *p_fileName, const std::set<std::string> &p_updatedUuids);
 
-	std::string searchWellboreTrajectory(const std::string &p_fileName);												  // traj
+	std::string searchWellboreTrajectory(const std::string &p_fileName, const std::set<std::string> &p_updatedUuids);	  // traj
 	std::string searchWellboreFrame(const resqml2::WellboreTrajectoryRepresentation *w_wellboreTrajectory, int p_nodeId); // frame/markerFrame + chanel + marker
 	std::string searchWellboreCompletion(const resqml2::WellboreFeature *w_wellboreTrajectory, int p_nodeId);			  // completion + perforation
 	std::string searchRepresentations(resqml2::AbstractRepresentation const *p_representation, int p_nodeId = 0 /* 0 is root's id*/);
 	int searchRepresentationSetRepresentation(resqml2::RepresentationSetRepresentation const *p_rsr, int p_nodeId = 0 /* 0 is root's id*/);
 	std::string searchSubRepresentation(resqml2::AbstractRepresentation const *p_representation, int p_nodeParent);
-	std::string searchTimeSeries(const std::string &p_fileName);
+	std::string searchTimeSeries(const std::string &p_fileName, const std::set<std::string> &p_updatedUuids);
 	int searchPropertySet(resqml2_0_1::PropertySet const *p_propSet, int p_nodeId);
 	std::string searchProperties(resqml2::AbstractRepresentation const *p_representation, int p_nodeParent);
 
+	/**
+	 * deserialize the xml of a partial data object (and of its partial targets) from the EPC document it comes from
+	 * @return the deserialized data object or p_object if it cannot be resolved
+	 */
+	common::AbstractObject *resolvePartial(common::AbstractObject *p_object);
+	/**
+	 * deserialize the (light) data objects required to build the tree: wellbores and time series
+	 */
+	void resolveWellboresAndTimeSeries(const std::set<std::string> &p_updatedUuids);
+
 	void selectNodeIdParent(int p_nodeId);
 	void selectNodeIdChildren(int p_nodeId);
 
 	/**
 	 * delete _oldSelection mapper
 	 */
-	void deleteMapper(double p_time);
+	void deleteMapper();
+	/**
+	 * delete all mappers (e.g. when the requested piece changes)
+	 */
+	void deleteAllMappers();
+	/**
+	 * keep the mapper of a deselected node in _cachedMappers as the most recently used one
+	 */
+	void cacheMapper(int p_nodeId);
+	/**
+	 * delete the least recently used mappers of _cachedMappers until they fit in _cacheSizeMB
+	 */
+	void evictCachedMappers();
+	/**
+	 * @return the memory (in kibibytes) of the mappers of _cachedMappers, plus the points of the supporting mappers of _supportingIjkGridMappers
+	 * whose subrepresentations are all cached
+	 */
+	unsigned long getCachedMappersMemorySize() const;
+	/**
+	 * delete the mapper of p_nodeId (a subrepresentation is unregistered from the mapper of its supporting grid)
+	 */
+	void deleteNodeMapper(int p_nodeId);
+	/**
+	 * stop the background reading of the time steps once the property being read is over
+	 */
+	void stopBackgroundTask();
+	/**
+	 * @return the size, modification time and inode of the file of p_hdfProxy (empty if it is not a local file)
+	 */
+	std::string getHdfFileState(eml2::AbstractHdfProxy const *p_hdfProxy) const;
+	/**
+	 * close the open HDF5 files which have been modified since their state has been recorded by recordHdfFileStates
+	 */
+	void closeModifiedHdfProxies();
+	void recordHdfFileStates();
 	/**
 	 * initialize _nodeIdToMapperSet
 	 */
 	void initMapperSet(const TreeViewNodeType p_type, const int p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId);
 	/**
-	 * initialize and load _nodeIdToMapper
+	 * initialize _nodeIdToMapper (the mapper is loaded by loadMappers)
+	 * @return the node id of the mapper which must be loaded by the same thread (supporting grid of a subrepresentation), p_nodeId otherwise
 	 */
-	void loadMapper(const TreeViewNodeType p_type, const int p_nodeId,const uint32_t p_nbProcess, const uint32_t p_processId);
-	void loadRepresentationMapper(const int p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId);
+	int loadMapper(const TreeViewNodeType p_type, const int p_nodeId,const uint32_t p_nbProcess, const uint32_t p_processId);
+	int loadRepresentationMapper(const int p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId);
 	void loadWellboreTrajectoryMapper(const int p_nodeId);
 	/**
+	 * load the mappers of _nodeIdToMapper on _numberOfThreads threads
+	 * @param p_loadingGroups	the node ids of the mappers to load, grouped by the node id returned by loadMapper
+	 */
+	void loadMappers(const std::map<int, std::vector<int>> &p_loadingGroups);
+	/**
  * add data to parent nodeId
  */
 	void addDataToParent(const TreeViewNodeType p_type, const int p_nodeId, const uint32_t p_nbProcess, const uint32_t p_processId, const double p_time);
@@ -142,6 +333,25 @@ private:
 	// node name from a given string.
 	std::string MakeValidNodeName(const char *p_name);
 
+	/**
+	 * add a node to the tree and to the node indexes
+	 * @return the id of the new node or -1 if it cannot be added
+	 */
+	int addNode(const std::string &p_nodeName, int p_parentNodeId, const std::string &p_label, TreeViewNodeType p_type);
+	/**
+	 * remove a node and its subtree from the tree and from the node indexes
+	 */
+	void removeNode(int p_nodeId);
+	/**
+	 * @return the id of the node named p_nodeName ("_" + uuid for a data object) or -1 if it is not in the tree
+	 */
+	int findNode(const std::string &p_nodeName) const;
+	TreeViewNodeType getNodeType(int p_nodeId) const;
+	/**
+	 * rebuild the node indexes when the whole tree has been replaced (e.g. restored from the cache)
+	 */
+	void rebuildNodeIndex();
+
 	bool _markerOrientation;
 	uint32_t _markerSize;
 
@@ -149,16 +359,68 @@ private:
 
 	vtkSmartPointer<vtkPartitionedDataSetCollection> _output;
 
-	std::map<int, CommonAbstractObjectToVtkPartitionedDataSet *> _nodeIdToMapper;		   // index of VtkDataAssembly to CommonAbstractObjectToVtkPartitionedDataSet
-	std::map<int, CommonAbstractObjectSetToVtkPartitionedDataSetSet *> _nodeIdToMapperSet; // index of VtkDataAssembly to CommonAbstractObjectSetToVtkPartitionedDataSetSet
+	std::unordered_map<int, CommonAbstractObjectToVtkPartitionedDataSet *> _nodeIdToMapper;		   // index of VtkDataAssembly to CommonAbstractObjectToVtkPartitionedDataSet
+	std::unordered_map<int, CommonAbstractObjectSetToVtkPartitionedDataSetSet *> _nodeIdToMapperSet; // index of VtkDataAssembly to CommonAbstractObjectSetToVtkPartitionedDataSetSet
+	// IJK grid uuid to the mapper giving the points of the whole grid to its subrepresentations, and the number of subrepresentation mappers using it:
+	// it is not the mapper of the grid node, which only loads the piece of the process and follows the stride and surface settings
+	std::unordered_map<std::string, std::pair<ResqmlIjkGridToVtkExplicitStructuredGrid *, uint32_t>> _supportingIjkGridMappers;
+
+	// indexes of the tree (kept in sync by addNode/removeNode) which avoid to scan the vtkDataAssembly
+	std::unordered_map<std::string, int> _nodeNameToNodeId;
+	std::unordered_map<int, TreeViewNodeType> _nodeIdToType;
 
 	//\/          uuid             title            index        prop_uuid
 	std::map<std::string, std::map<std::string, std::map<double, std::string>>> _timeSeriesUuidAndTitleToIndexAndPropertiesUuid;
+	// time series node id to the property uuid of the time step added to its representation
+	std::unordered_map<int, std::string> _timeSeriesNodeIdToPropertyUuid;
 
 	std::set<int> _currentSelection;
 	std::set<int> _oldSelection;
 
 	std::set<std::string> _files;
+	std::string _loadingTimes;
+	// phase name to duration (ms), in the phase order
+	std::vector<std::pair<std::string, double>> _filePhaseTimes;
+	std::vector<std::pair<std::string, double>> _updatePhaseTimes;
+
+	// lazy loading: EPC documents kept open to deserialize the data objects on demand
+	bool _lazyLoading;
+	std::vector<common::EpcDocument *> _epcDocuments;
+	std::map<std::string, common::EpcDocument *> _uuidToEpcDocument;
+
+	// cache of the tree (user cache directory)
+	bool _useCache;
+	bool _writeCache;
+
+	uint32_t _numberOfThreads;
+
+	bool _singlePrecision;
+	uint32_t _ghostLevels;
+	uint32_t _stride;
+	bool _surfaceOnly;
+
+	// IJK grid uuid to the hyperslabing capacity of its geometry, checked again when the files are reloaded
+	std::unordered_map<std::string, bool> _ijkGridHyperslabingCapacities;
+
+	// mappers of the deselected nodes: node id and memory size (in KiB), the most recently used first
+	uint32_t _cacheSizeMB;
+	std::list<std::pair<int, unsigned long>> _cachedMappers;
+
+	// background reading of the next time steps: property uuid to values not yet added to their representation
+	uint32_t _numberOfPrefetchedTimeSteps;
+	std::map<std::string, ResqmlPropertyToVtkDataArray *> _prefetchedDataArrays;
+	std::future<void> _backgroundTask;
+	std::atomic<bool> _stopBackgroundTask;
+	std::mutex _backgroundTaskMutex;
+	std::condition_variable _backgroundTaskCondition;
+
+	// HDF5 files kept open between two updates: HDF proxy uuid to the state of its file
+	uint32_t _hdfIdleTimeout;
+	std::map<std::string, std::string> _hdfFileStates;
+
+	// piece (process id) and number of pieces used to build the current mappers
+	uint32_t _nbProcess;
+	uint32_t _processId;
 
 	// time step values
 	std::vector<double> _timesStep;
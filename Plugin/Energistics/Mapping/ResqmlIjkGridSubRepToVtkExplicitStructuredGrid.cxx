@@ -19,6 +19,7 @@ under the License.
 #include "Mapping/ResqmlIjkGridSubRepToVtkExplicitStructuredGrid.h"
 
 #include <array>
+#include <vector>
 
 // include VTK library
 #include <vtkSmartPointer.h>
@@ -81,6 +82,7 @@ void ResqmlIjkGridSubRepToVtkExplicitStructuredGrid::loadVtkObject()
 	vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid = vtkSmartPointer<vtkUnstructuredGrid>::New();
 
 	vtk_unstructuredGrid->SetPoints(this->getMapperVtkPoint());
+	this->mapperIjkGrid->addLocalOrigin(vtk_unstructuredGrid);
 
 	// Define hexahedron node ordering according to Paraview convention : https://lorensen.github.io/VTKExamples/site/VTKBook/05Chapter5/#Figure%205-3
 	std::array<unsigned int, 8> correspondingResqmlCornerId = { 0, 1, 2, 3, 4, 5, 6, 7 };
@@ -102,32 +104,41 @@ void ResqmlIjkGridSubRepToVtkExplicitStructuredGrid::loadVtkObject()
 	_jCellCount = supportingGrid->getJCellCount();
 	_kCellCount = supportingGrid->getKCellCount();
 
+	// the point indices of the hexahedra are read from fesapi while holding the fesapi lock
+	std::vector<vtkIdType> hexahedronPointIds;
+	hexahedronPointIds.reserve(elementCountOfPatch * 8);
 	size_t indice = 0;
-
 	for (uint_fast32_t vtkKCellIndex = 0; vtkKCellIndex < _kCellCount; ++vtkKCellIndex)
 	{
 		for (uint_fast32_t vtkJCellIndex = 0; vtkJCellIndex < _jCellCount; ++vtkJCellIndex)
 		{
 			for (uint_fast32_t vtkICellIndex = 0; vtkICellIndex < _iCellCount; ++vtkICellIndex)
 			{
-				if (elementIndices[indice] == cellIndex)
+				if (indice < elementCountOfPatch && elementIndices[indice] == cellIndex)
 				{
-					vtkSmartPointer<vtkHexahedron> hex = vtkSmartPointer<vtkHexahedron>::New();
-
 					for (uint_fast8_t cornerId = 0; cornerId < 8; ++cornerId)
 					{
-						hex->GetPointIds()->SetId(cornerId,
-							supportingGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, correspondingResqmlCornerId[cornerId]));
+						hexahedronPointIds.push_back(supportingGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, correspondingResqmlCornerId[cornerId]));
 					}
-					vtk_unstructuredGrid->InsertNextCell(hex->GetCellType(), hex->GetPointIds());
 					indice++;
 				}
 				++cellIndex;
 			}
 		}
 	}
-
 	supportingGrid->unloadSplitInformation();
+
+	{
+		// the hexahedra are inserted in the VTK grid without holding the fesapi lock
+		FesapiUnlock fesapiUnlock;
+		const size_t hexahedronCount = hexahedronPointIds.size() / 8;
+		vtk_unstructuredGrid->Allocate(hexahedronCount);
+		for (size_t hexahedronIndex = 0; hexahedronIndex < hexahedronCount; ++hexahedronIndex)
+		{
+			vtk_unstructuredGrid->InsertNextCell(VTK_HEXAHEDRON, 8, hexahedronPointIds.data() + hexahedronIndex * 8);
+		}
+	}
+
 	_vtkData->SetPartition(0, vtk_unstructuredGrid);
 	_vtkData->Modified();
 }
@@ -139,6 +150,12 @@ std::string ResqmlIjkGridSubRepToVtkExplicitStructuredGrid::unregisterToMapperSu
 	return this->mapperIjkGrid->getUuid();
 }
 
+//----------------------------------------------------------------------------
+std::string ResqmlIjkGridSubRepToVtkExplicitStructuredGrid::getSupportingGridUuid() const
+{
+	return this->mapperIjkGrid->getUuid();
+}
+
 //----------------------------------------------------------------------------
 vtkSmartPointer<vtkPoints> ResqmlIjkGridSubRepToVtkExplicitStructuredGrid::getMapperVtkPoint()
 {
@@ -53,6 +53,11 @@ public:
 	 */
 	std::string unregisterToMapperSupportingGrid();
 
+	/**
+	 * @return the uuid of the IJK grid giving its points to the subrepresentation
+	 */
+	std::string getSupportingGridUuid() const;
+
 protected:
 	const RESQML2_NS::SubRepresentation *getResqmlData() const;
 
@@ -18,7 +18,15 @@ under the License.
 -----------------------------------------------------------------------*/
 #include "Mapping/ResqmlIjkGridToVtkExplicitStructuredGrid.h"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 // include VTK library
 #include <vtkSmartPointer.h>
@@ -28,52 +36,210 @@ under the License.
 #include <vtkEmptyCell.h>
 #include <vtkHexahedron.h>
 #include <vtkExplicitStructuredGrid.h>
+#include <vtkSMPTools.h>
+#include <vtkCellArray.h>
+#include <vtkIdList.h>
+#include <vtkIdTypeArray.h>
+#include <vtkPolyData.h>
+#include <vtkStructuredGrid.h>
+#include <vtkImageData.h>
+#include <vtkMath.h>
+#include <vtkUnsignedCharArray.h>
+#include <vtkDataSetAttributes.h>
 #include "vtkPointData.h"
 
 // include FESAPI
 #include <fesapi/resqml2/AbstractIjkGridRepresentation.h>
+#include <fesapi/resqml2/IjkGridLatticeRepresentation.h>
 #include <fesapi/resqml2/LocalDepth3dCrs.h>
 
 // include FESPP
 #include "ResqmlPropertyToVtkDataArray.h"
 
 //----------------------------------------------------------------------------
-ResqmlIjkGridToVtkExplicitStructuredGrid::ResqmlIjkGridToVtkExplicitStructuredGrid(const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid, uint32_t p_procNumber, uint32_t p_maxProc)
+ResqmlIjkGridToVtkExplicitStructuredGrid::ResqmlIjkGridToVtkExplicitStructuredGrid(const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid, uint32_t p_procNumber, uint32_t p_maxProc, uint32_t p_ghostLevels,
+																				   std::unordered_map<std::string, bool> *p_hyperslabingCapacities)
 	: ResqmlAbstractRepresentationToVtkPartitionedDataSet(ijkGrid,
 														  p_procNumber,
 														  p_maxProc),
 	  points(vtkSmartPointer<vtkPoints>::New()),
-	  pointer_on_points(0)
+	  pointer_on_points(0),
+	  ghostLevels(0),
+	  ownedBlock(),
+	  surfaceOnly(false)
 {
 	_iCellCount = ijkGrid->getICellCount();
 	_jCellCount = ijkGrid->getJCellCount();
 	_kCellCount = ijkGrid->getKCellCount();
 	_pointCount = ijkGrid->getXyzPointCountOfAllPatches();
-	checkHyperslabingCapacity(ijkGrid);
+	checkHyperslabingCapacity(ijkGrid, p_hyperslabingCapacities);
 
-	if (_isHyperslabed)
+	_initIIndex = 0;
+	_maxIIndex = _iCellCount;
+	_initJIndex = 0;
+	_maxJIndex = _jCellCount;
+	_initKIndex = 0;
+	_maxKIndex = _kCellCount;
+	if (_isHyperslabed && _maxProc > 1)
 	{
-		const auto optim = (_kCellCount % p_maxProc) > 0 ? (_kCellCount / p_maxProc) + 1 : _kCellCount / p_maxProc;
-		_initKIndex = _procNumber * optim;
-		if (_initKIndex >= _kCellCount)
+		computeBlock(ijkGrid);
+
+		// the ghost layers extend the block on each side, within the grid
+		if (_initKIndex < _maxKIndex)
 		{
-			_initKIndex = 0;
-			_maxKIndex = 0;
+			ghostLevels = p_ghostLevels;
+			ownedBlock = { _initIIndex, _maxIIndex, _initJIndex, _maxJIndex, _initKIndex, _maxKIndex };
+			_initIIndex = _initIIndex > ghostLevels ? _initIIndex - ghostLevels : 0;
+			_maxIIndex = (std::min)(_maxIIndex + ghostLevels, _iCellCount);
+			_initJIndex = _initJIndex > ghostLevels ? _initJIndex - ghostLevels : 0;
+			_maxJIndex = (std::min)(_maxJIndex + ghostLevels, _jCellCount);
+			_initKIndex = _initKIndex > ghostLevels ? _initKIndex - ghostLevels : 0;
+			_maxKIndex = (std::min)(_maxKIndex + ghostLevels, _kCellCount);
 		}
-		else
+	}
+
+	_vtkData = vtkSmartPointer<vtkPartitionedDataSet>::New();
+}
+
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::setStride(uint32_t stride)
+{
+	_stride = stride < 1 ? 1 : stride;
+	if (_stride > 1 && ghostLevels > 0)
+	{
+		// the coarse cells of the owned blocks do not overlap: no ghost cell in a preview
+		ghostLevels = 0;
+		_initIIndex = ownedBlock[0];
+		_maxIIndex = ownedBlock[1];
+		_initJIndex = ownedBlock[2];
+		_maxJIndex = ownedBlock[3];
+		_initKIndex = ownedBlock[4];
+		_maxKIndex = ownedBlock[5];
+	}
+}
+
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::computeBlock(const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid)
+{
+	// Blocks along K first since the K layers are contiguous in the HDF5 datasets: one K slab per process if there are enough layers,
+	// else the processes of a K slab are spread over J, then the processes of a J range over I.
+	const uint32_t kBlockCount = (std::min)(_maxProc, _kCellCount);
+	uint32_t kBlockIndex = 0;
+	uint32_t kRankIndex = 0;
+	uint32_t kRankCount = 0;
+	spreadRanks(_procNumber, _maxProc, kBlockCount, kBlockIndex, kRankIndex, kRankCount);
+	const uint32_t jBlockCount = (std::min)(kRankCount, _jCellCount);
+	uint32_t jBlockIndex = 0;
+	uint32_t iBlockIndex = 0;
+	uint32_t iBlockCount = 0;
+	spreadRanks(kRankIndex, kRankCount, jBlockCount, jBlockIndex, iBlockIndex, iBlockCount);
+
+	// the cells without geometry are not taken into account to balance the blocks
+	const bool *enabledCells = getEnabledCells();
+	const auto isEnabled = [&](uint32_t iCellIndex, uint32_t jCellIndex, uint32_t kCellIndex) -> bool
+	{
+		return enabledCells[(static_cast<uint64_t>(kCellIndex) * _jCellCount + jCellIndex) * _iCellCount + iCellIndex];
+	};
+
+	// Recursive bisection: the K slab balances the active cells of the grid, the J range the ones of the K slab
+	// and the I range the ones of the J range of the K slab.
+	std::vector<uint64_t> activeCellCounts(_kCellCount, 0);
+	for (uint32_t kCellIndex = 0; kCellIndex < _kCellCount; ++kCellIndex)
+	{
+		for (uint32_t jCellIndex = 0; jCellIndex < _jCellCount; ++jCellIndex)
+		{
+			for (uint32_t iCellIndex = 0; iCellIndex < _iCellCount; ++iCellIndex)
+			{
+				activeCellCounts[kCellIndex] += isEnabled(iCellIndex, jCellIndex, kCellIndex) ? 1 : 0;
+			}
+		}
+	}
+	splitBalanced(activeCellCounts, kBlockCount, kBlockIndex, _initKIndex, _maxKIndex);
+
+	activeCellCounts.assign(_jCellCount, 0);
+	for (uint32_t kCellIndex = _initKIndex; kCellIndex < _maxKIndex; ++kCellIndex)
+	{
+		for (uint32_t jCellIndex = 0; jCellIndex < _jCellCount; ++jCellIndex)
 		{
-			_maxKIndex = _procNumber == _maxProc - 1
-								  ? _kCellCount
-								  : _initKIndex + optim;
+			for (uint32_t iCellIndex = 0; iCellIndex < _iCellCount; ++iCellIndex)
+			{
+				activeCellCounts[jCellIndex] += isEnabled(iCellIndex, jCellIndex, kCellIndex) ? 1 : 0;
+			}
 		}
 	}
-	else
+	splitBalanced(activeCellCounts, jBlockCount, jBlockIndex, _initJIndex, _maxJIndex);
+
+	activeCellCounts.assign(_iCellCount, 0);
+	for (uint32_t kCellIndex = _initKIndex; kCellIndex < _maxKIndex; ++kCellIndex)
 	{
-		_initKIndex = 0;
-		_maxKIndex = _kCellCount;
+		for (uint32_t jCellIndex = _initJIndex; jCellIndex < _maxJIndex; ++jCellIndex)
+		{
+			for (uint32_t iCellIndex = 0; iCellIndex < _iCellCount; ++iCellIndex)
+			{
+				activeCellCounts[iCellIndex] += isEnabled(iCellIndex, jCellIndex, kCellIndex) ? 1 : 0;
+			}
+		}
 	}
+	splitBalanced(activeCellCounts, iBlockCount, iBlockIndex, _initIIndex, _maxIIndex);
 
-	_vtkData = vtkSmartPointer<vtkPartitionedDataSet>::New();
+	// a process without any cell
+	if (_initIIndex == _maxIIndex || _initJIndex == _maxJIndex || _initKIndex == _maxKIndex)
+	{
+		_initIIndex = _maxIIndex = _initJIndex = _maxJIndex = _initKIndex = _maxKIndex = 0;
+	}
+}
+
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::spreadRanks(uint32_t rank, uint32_t rankCount, uint32_t blockCount, uint32_t &blockIndex, uint32_t &rankIndexInBlock, uint32_t &rankCountInBlock)
+{
+	// the first rank of the block b is ceil(b * rankCount / blockCount)
+	const auto getFirstRank = [&](uint32_t block) -> uint32_t
+	{
+		return static_cast<uint32_t>((static_cast<uint64_t>(block) * rankCount + blockCount - 1) / blockCount);
+	};
+	blockIndex = static_cast<uint32_t>(static_cast<uint64_t>(rank) * blockCount / rankCount);
+	rankIndexInBlock = rank - getFirstRank(blockIndex);
+	rankCountInBlock = getFirstRank(blockIndex + 1) - getFirstRank(blockIndex);
+}
+
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::splitBalanced(const std::vector<uint64_t> &weights, uint32_t partCount, uint32_t partIndex, uint32_t &begin, uint32_t &end)
+{
+	const uint32_t count = static_cast<uint32_t>(weights.size());
+	partCount = (std::min)(partCount, count);
+	if (partIndex >= partCount)
+	{
+		begin = end = 0;
+		return;
+	}
+
+	uint64_t totalWeight = 0;
+	for (const uint64_t weight : weights)
+	{
+		totalWeight += weight;
+	}
+	// first index of a part: the cumulated weight reaches its share, each part keeping at least one index
+	const auto getFirstIndex = [&](uint32_t part) -> uint32_t
+	{
+		if (part == 0)
+		{
+			return 0;
+		}
+		if (part == partCount)
+		{
+			return count;
+		}
+		const double targetWeight = static_cast<double>(totalWeight) * part / partCount;
+		uint32_t index = 0;
+		uint64_t cumulatedWeight = 0;
+		while (index < count && (totalWeight == 0 ? index < static_cast<uint64_t>(count) * part / partCount : cumulatedWeight < targetWeight))
+		{
+			cumulatedWeight += weights[index++];
+		}
+		return (std::max)(part, (std::min)(index, count - (partCount - part)));
+	};
+	begin = getFirstIndex(partIndex);
+	end = getFirstIndex(partIndex + 1);
 }
 
 //----------------------------------------------------------------------------
@@ -83,20 +249,48 @@ const RESQML2_NS::AbstractIjkGridRepresentation *ResqmlIjkGridToVtkExplicitStruc
 }
 
 //----------------------------------------------------------------------------
-void ResqmlIjkGridToVtkExplicitStructuredGrid::checkHyperslabingCapacity(const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid)
+void ResqmlIjkGridToVtkExplicitStructuredGrid::checkHyperslabingCapacity(const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid, std::unordered_map<std::string, bool> *hyperslabingCapacities)
 {
-	try
+	// the capacity only depends on the geometry of the grid: it is checked once per grid, not each time a mapper is created
+	if (hyperslabingCapacities != nullptr)
 	{
-		const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
-		const auto kInterfaceNodeCount = ijkGrid->getXyzPointCountOfKInterface();
-		std::unique_ptr<double[]> allXyzPoints(new double[kInterfaceNodeCount * 3]);
-		const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->getXyzPointsOfKInterface(0, allXyzPoints.get());
-		_isHyperslabed = true;
+		const auto capacity = hyperslabingCapacities->find(ijkGrid->getUuid());
+		if (capacity != hyperslabingCapacities->end())
+		{
+			_isHyperslabed = capacity->second;
+			return;
+		}
 	}
-	catch (const std::exception &)
+
+	switch (ijkGrid->getGeometryKind())
 	{
+	case RESQML2_NS::AbstractIjkGridRepresentation::geometryKind::EXPLICIT:
+		// the points are stored K interface by K interface in their HDF5 dataset: no need to read them
+		_isHyperslabed = true;
+		break;
+	case RESQML2_NS::AbstractIjkGridRepresentation::geometryKind::PARAMETRIC:
+	case RESQML2_NS::AbstractIjkGridRepresentation::geometryKind::LATTICE:
+		// the points are computed from the geometry parameters: only a reading tells if fesapi supports it for a single K interface
+		try
+		{
+			const auto kInterfaceNodeCount = ijkGrid->getXyzPointCountOfKInterface();
+			std::unique_ptr<double[]> allXyzPoints(new double[kInterfaceNodeCount * 3]);
+			const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->getXyzPointsOfKInterface(0, allXyzPoints.get());
+			_isHyperslabed = true;
+		}
+		catch (const std::exception &)
+		{
+			_isHyperslabed = false;
+		}
+		break;
+	default:
+		// no geometry
 		_isHyperslabed = false;
 	}
+	if (hyperslabingCapacities != nullptr)
+	{
+		(*hyperslabingCapacities)[ijkGrid->getUuid()] = _isHyperslabed;
+	}
 }
 
 //----------------------------------------------------------------------------
@@ -113,65 +307,679 @@ void ResqmlIjkGridToVtkExplicitStructuredGrid::loadVtkObject()
 		throw std::out_of_range("too many kLayer: " + std::to_string(_maxKIndex));
 	}
 
-	vtkExplicitStructuredGrid* vtk_explicitStructuredGrid = vtkExplicitStructuredGrid::New();
-	int extent[6] = { 0, static_cast<int>(_iCellCount), 0, static_cast<int>(_jCellCount), static_cast<int>(_initKIndex), static_cast<int>(_maxKIndex) };
+	// preview: a cell every stride cells along each axis
+	if (_stride > 1)
+	{
+		loadCoarsenedGrid();
+		return;
+	}
+
+	// only the boundary faces of the cells
+	if (surfaceOnly)
+	{
+		loadSurface();
+		return;
+	}
+
+	// a regular lattice is entirely defined by its origin and its axes: neither points nor connectivity
+	if (loadRegularLattice())
+	{
+		return;
+	}
+
+	// the points first: they may reset the block to the whole grid
+	vtkSmartPointer<vtkPoints> gridPoints = getVtkPoints();
+	const RESQML2_NS::AbstractIjkGridRepresentation* ijkGrid = getResqmlData();
+
+	// without split node nor K gap, the nodes are the ones of a structured grid: the connectivity is implicit
+	if (ijkGrid->getSplitCoordinateLineCount() == 0 && ijkGrid->getKGapsCount() == 0)
+	{
+		loadStructuredGrid(gridPoints);
+		return;
+	}
+
+	vtkSmartPointer<vtkExplicitStructuredGrid> vtk_explicitStructuredGrid = vtkSmartPointer<vtkExplicitStructuredGrid>::New();
+	int extent[6] = { static_cast<int>(_initIIndex), static_cast<int>(_maxIIndex), static_cast<int>(_initJIndex), static_cast<int>(_maxJIndex), static_cast<int>(_initKIndex), static_cast<int>(_maxKIndex) };
 	vtk_explicitStructuredGrid->SetExtent(extent);
-	vtk_explicitStructuredGrid->SetPoints(getVtkPoints());
+	vtk_explicitStructuredGrid->SetPoints(gridPoints);
+	addLocalOrigin(vtk_explicitStructuredGrid);
 
 	// Check which cells have no geometry
-	const RESQML2_NS::AbstractIjkGridRepresentation* ijkGrid = getResqmlData();
-	const uint64_t cellCount = ijkGrid->getCellCount();
-	std::unique_ptr<bool[]> enabledCells(new bool[cellCount]);
-	if (ijkGrid->hasCellGeometryIsDefinedFlags())
+	const bool *enabledCells = getEnabledCells();
+
+	// K interface at the top of each layer (the bottom one is the next interface)
+	const uint64_t kInterfaceNodeCount = ijkGrid->getXyzPointCountOfKInterface();
+	const std::vector<uint64_t> topKInterface = getTopKInterfaces();
+	const uint64_t translatePoint = _initKIndex < _kCellCount ? kInterfaceNodeCount * topKInterface[_initKIndex] : 0;
+
+	const uint32_t blockICellCount = _maxIIndex - _initIIndex;
+	const uint64_t columnCount = static_cast<uint64_t>(_iCellCount) * _jCellCount;
+	const uint64_t blockColumnCount = static_cast<uint64_t>(blockICellCount) * (_maxJIndex - _initJIndex);
+	const bool hasSplitNodes = ijkGrid->getSplitCoordinateLineCount() > 0;
+	if (hasSplitNodes)
 	{
-		ijkGrid->getCellGeometryIsDefinedFlags(enabledCells.get());
+		const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->loadSplitInformation();
 	}
-	else
+
+	// the 4 corner nodes of each column of the block, within a K interface (fesapi resolves the split nodes)
+	const std::vector<uint64_t> columnCorners = getColumnCorners(_initIIndex, _maxIIndex, _initJIndex, _maxJIndex,
+																  hasSplitNodes ? kInterfaceNodeCount * topKInterface[_initKIndex] : 0);
+	if (hasSplitNodes)
 	{
-		std::fill_n(enabledCells.get(), cellCount, true);
+		const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->unloadSplitInformation();
 	}
 
-	const uint64_t translatePoint = ijkGrid->getXyzPointCountOfKInterface() * _initKIndex;
+	{
+		// the corners are in memory: the cells are built without holding the fesapi lock
+		FesapiUnlock fesapiUnlock;
+		// each K layer writes its own cells
+		vtkSMPTools::For(_initKIndex, _maxKIndex, [&](vtkIdType beginKIndex, vtkIdType endKIndex) -> void
+		{
+			for (vtkIdType vtkKCellIndex = beginKIndex; vtkKCellIndex < endKIndex; ++vtkKCellIndex)
+			{
+				const vtkIdType topOffset = kInterfaceNodeCount * topKInterface[vtkKCellIndex] - translatePoint;
+				const vtkIdType bottomOffset = topOffset + kInterfaceNodeCount;
+				for (uint64_t columnIndex = 0; columnIndex < blockColumnCount; ++columnIndex)
+				{
+					const uint32_t iCellIndex = _initIIndex + columnIndex % blockICellCount;
+					const uint32_t jCellIndex = _initJIndex + static_cast<uint32_t>(columnIndex / blockICellCount);
+					if (enabledCells[vtkKCellIndex * columnCount + static_cast<uint64_t>(jCellIndex) * _iCellCount + iCellIndex])
+					{
+						vtkIdType *indice = vtk_explicitStructuredGrid->GetCellPoints(vtk_explicitStructuredGrid->ComputeCellId(iCellIndex, jCellIndex, vtkKCellIndex));
+						const uint64_t *corners = columnCorners.data() + columnIndex * 4;
+						indice[0] = corners[0] + topOffset;
+						indice[1] = corners[1] + topOffset;
+						indice[2] = corners[2] + topOffset;
+						indice[3] = corners[3] + topOffset;
+						indice[4] = corners[0] + bottomOffset;
+						indice[5] = corners[1] + bottomOffset;
+						indice[6] = corners[2] + bottomOffset;
+						indice[7] = corners[3] + bottomOffset;
+					}
+				}
+			}
+		});
+		addCellGhostArray(vtk_explicitStructuredGrid, enabledCells);
+		vtk_explicitStructuredGrid->CheckAndReorderFaces();
+		vtk_explicitStructuredGrid->ComputeFacesConnectivityFlagsArray();
+	}
+
+	_vtkData->SetPartition(0, vtk_explicitStructuredGrid);
+	_vtkData->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool ResqmlIjkGridToVtkExplicitStructuredGrid::getCrsTransformation(double &xOffset, double &yOffset, double &zOffset, double &zIndice) const
+{
+	auto const *crs = getResqmlData()->getLocalCrs(0);
+	if (crs == nullptr || crs->isPartial())
+	{
+		return false;
+	}
+	xOffset = crs->getOriginOrdinal1();
+	yOffset = crs->getOriginOrdinal2();
+	auto const *depthCrs = dynamic_cast<RESQML2_NS::LocalDepth3dCrs const *>(crs);
+	zOffset = depthCrs != nullptr ? depthCrs->getOriginDepthOrElevation() : 0;
+	zIndice = crs->isDepthOriented() ? -1. : 1.;
+	return true;
+}
 
-	const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->loadSplitInformation();
+//----------------------------------------------------------------------------
+std::vector<uint64_t> ResqmlIjkGridToVtkExplicitStructuredGrid::getTopKInterfaces() const
+{
+	const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
+	std::vector<uint64_t> topKInterface(_kCellCount);
+	for (uint32_t kLayer = 0; kLayer < _kCellCount; ++kLayer)
+	{
+		topKInterface[kLayer] = kLayer;
+	}
+	if (ijkGrid->getKGapsCount() > 0)
+	{
+		std::unique_ptr<bool[]> gapAfterLayer(new bool[_kCellCount - 1]);
+		ijkGrid->getKGaps(gapAfterLayer.get());
+		for (uint32_t kLayer = 1; kLayer < _kCellCount; ++kLayer)
+		{
+			topKInterface[kLayer] = topKInterface[kLayer - 1] + (gapAfterLayer[kLayer - 1] ? 2 : 1);
+		}
+	}
+	return topKInterface;
+}
 
-	uint64_t cellIndex = 0;
-	for (uint_fast32_t vtkKCellIndex = _initKIndex; vtkKCellIndex < _maxKIndex; ++vtkKCellIndex)
+//----------------------------------------------------------------------------
+std::vector<uint64_t> ResqmlIjkGridToVtkExplicitStructuredGrid::getColumnCorners(uint32_t initIIndex, uint32_t maxIIndex, uint32_t initJIndex, uint32_t maxJIndex, uint64_t topNodeOffset) const
+{
+	const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
+	std::vector<uint64_t> columnCorners(static_cast<uint64_t>(maxIIndex - initIIndex) * (maxJIndex - initJIndex) * 4);
+	uint64_t columnIndex = 0;
+	if (ijkGrid->getSplitCoordinateLineCount() > 0)
 	{
-		for (uint_fast32_t vtkJCellIndex = 0; vtkJCellIndex < _jCellCount; ++vtkJCellIndex)
+		// fesapi resolves the split coordinate lines once per column instead of once per cell
+		for (uint32_t jCellIndex = initJIndex; jCellIndex < maxJIndex; ++jCellIndex)
 		{
-			for (uint_fast32_t vtkICellIndex = 0; vtkICellIndex < _iCellCount; ++vtkICellIndex)
+			for (uint32_t iCellIndex = initIIndex; iCellIndex < maxIIndex; ++iCellIndex)
 			{
-				vtkIdType cellId = vtk_explicitStructuredGrid->ComputeCellId(vtkICellIndex, vtkJCellIndex, vtkKCellIndex);
-				if (enabledCells[cellIndex++])
+				for (unsigned int corner = 0; corner < 4; ++corner)
 				{
-					vtkIdType *indice = vtk_explicitStructuredGrid->GetCellPoints(cellId);
-					indice[0] = ijkGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, 0) - translatePoint;
-					indice[1] = ijkGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, 1) - translatePoint;
-					indice[2] = ijkGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, 2) - translatePoint;
-					indice[3] = ijkGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, 3) - translatePoint;
-					indice[4] = ijkGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, 4) - translatePoint;
-					indice[5] = ijkGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, 5) - translatePoint;
-					indice[6] = ijkGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, 6) - translatePoint;
-					indice[7] = ijkGrid->getXyzPointIndexFromCellCorner(vtkICellIndex, vtkJCellIndex, vtkKCellIndex, 7) - translatePoint;
+					columnCorners[columnIndex * 4 + corner] = ijkGrid->getXyzPointIndexFromCellCorner(iCellIndex, jCellIndex, _initKIndex, corner) - topNodeOffset;
 				}
-				else
+				++columnIndex;
+			}
+		}
+	}
+	else
+	{
+		// no split coordinate line: the nodes of a K interface are the pillars, I being the fastest index
+		const uint64_t pillarICount = static_cast<uint64_t>(_iCellCount) + 1;
+		for (uint64_t jCellIndex = initJIndex; jCellIndex < maxJIndex; ++jCellIndex)
+		{
+			for (uint64_t iCellIndex = initIIndex; iCellIndex < maxIIndex; ++iCellIndex)
+			{
+				const uint64_t pillarIndex = iCellIndex + jCellIndex * pillarICount;
+				columnCorners[columnIndex * 4] = pillarIndex;
+				columnCorners[columnIndex * 4 + 1] = pillarIndex + 1;
+				columnCorners[columnIndex * 4 + 2] = pillarIndex + pillarICount + 1;
+				columnCorners[columnIndex * 4 + 3] = pillarIndex + pillarICount;
+				++columnIndex;
+			}
+		}
+	}
+	return columnCorners;
+}
+
+//----------------------------------------------------------------------------
+const bool *ResqmlIjkGridToVtkExplicitStructuredGrid::getEnabledCells()
+{
+	if (cellGeometryIsDefined == nullptr)
+	{
+		const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
+		const uint64_t cellCount = ijkGrid->getCellCount();
+		cellGeometryIsDefined.reset(new bool[cellCount]);
+		if (ijkGrid->hasCellGeometryIsDefinedFlags())
+		{
+			ijkGrid->getCellGeometryIsDefinedFlags(cellGeometryIsDefined.get());
+		}
+		else
+		{
+			std::fill_n(cellGeometryIsDefined.get(), cellCount, true);
+		}
+	}
+	return cellGeometryIsDefined.get();
+}
+
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::addCellGhostArray(vtkDataSet *dataSet, const bool *enabledCells) const
+{
+	// the cells of the dataset follow the I/J/K order of the block, I being the fastest
+	vtkUnsignedCharArray *ghostArray = nullptr;
+	vtkIdType cellId = 0;
+	for (uint32_t kCellIndex = _initKIndex; kCellIndex < _maxKIndex; ++kCellIndex)
+	{
+		const bool isGhostLayer = ghostLevels > 0 && (kCellIndex < ownedBlock[4] || kCellIndex >= ownedBlock[5]);
+		for (uint32_t jCellIndex = _initJIndex; jCellIndex < _maxJIndex; ++jCellIndex)
+		{
+			const bool isGhostRow = isGhostLayer || (ghostLevels > 0 && (jCellIndex < ownedBlock[2] || jCellIndex >= ownedBlock[3]));
+			const bool *rowEnabledCells = enabledCells + (static_cast<uint64_t>(kCellIndex) * _jCellCount + jCellIndex) * _iCellCount;
+			for (uint32_t iCellIndex = _initIIndex; iCellIndex < _maxIIndex; ++iCellIndex, ++cellId)
+			{
+				// the cells without geometry are hidden, the cells around the block of the process belong to the neighbouring processes
+				unsigned char ghostType = rowEnabledCells[iCellIndex] ? 0 : vtkDataSetAttributes::HIDDENCELL;
+				if (isGhostRow || (ghostLevels > 0 && (iCellIndex < ownedBlock[0] || iCellIndex >= ownedBlock[1])))
 				{
-					vtk_explicitStructuredGrid->BlankCell(cellId);
+					ghostType |= vtkDataSetAttributes::DUPLICATECELL;
+				}
+				if (ghostType != 0)
+				{
+					if (ghostArray == nullptr)
+					{
+						dataSet->AllocateCellGhostArray();
+						ghostArray = dataSet->GetCellGhostArray();
+					}
+					ghostArray->SetValue(cellId, ghostArray->GetValue(cellId) | ghostType);
 				}
 			}
 		}
 	}
+}
 
-	const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->unloadSplitInformation();
+//----------------------------------------------------------------------------
+bool ResqmlIjkGridToVtkExplicitStructuredGrid::loadRegularLattice()
+{
+	const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
+	if (ijkGrid->getGeometryKind() != RESQML2_NS::AbstractIjkGridRepresentation::geometryKind::LATTICE ||
+		ijkGrid->getKGapsCount() > 0)
+	{
+		return false;
+	}
+	auto const *lattice = dynamic_cast<RESQML2_NS::IjkGridLatticeRepresentation const *>(ijkGrid);
+	double xOffset = .0;
+	double yOffset = .0;
+	double zOffset = .0;
+	double zIndice = 1.;
+	if (lattice == nullptr || !getCrsTransformation(xOffset, yOffset, zOffset, zIndice))
+	{
+		return false;
+	}
 
-	vtk_explicitStructuredGrid->CheckAndReorderFaces();
-	vtk_explicitStructuredGrid->ComputeFacesConnectivityFlagsArray();
+	// origin and vector between two consecutive nodes along each axis, in the local CRS
+	std::array<double, 3> origin;
+	std::array<std::array<double, 3>, 3> axes;
+	try
+	{
+		origin = { lattice->getXOrigin(), lattice->getYOrigin(), lattice->getZOrigin() };
+		axes[0] = { lattice->getXIOffset(), lattice->getYIOffset(), lattice->getZIOffset() };
+		axes[1] = { lattice->getXJOffset(), lattice->getYJOffset(), lattice->getZJOffset() };
+		axes[2] = { lattice->getXKOffset(), lattice->getYKOffset(), lattice->getZKOffset() };
+		const std::array<double, 3> spacings = { lattice->getISpacing(), lattice->getJSpacing(), lattice->getKSpacing() };
+		for (size_t axis = 0; axis < 3; ++axis)
+		{
+			for (double &coordinate : axes[axis])
+			{
+				coordinate *= spacings[axis];
+			}
+		}
+	}
+	catch (const std::exception &)
+	{
+		// the spacing is not constant along an axis
+		return false;
+	}
+
+	// vtkImageData needs orthogonal axes: its direction matrix is a rotation (or a reflection)
+	std::array<double, 3> spacing;
+	for (size_t axis = 0; axis < 3; ++axis)
+	{
+		axes[axis][2] *= zIndice;
+		spacing[axis] = vtkMath::Norm(axes[axis].data());
+		if (spacing[axis] <= 0)
+		{
+			return false;
+		}
+		vtkMath::MultiplyScalar(axes[axis].data(), 1 / spacing[axis]);
+	}
+	const double tolerance = 1e-6;
+	if (std::abs(vtkMath::Dot(axes[0].data(), axes[1].data())) > tolerance ||
+		std::abs(vtkMath::Dot(axes[0].data(), axes[2].data())) > tolerance ||
+		std::abs(vtkMath::Dot(axes[1].data(), axes[2].data())) > tolerance)
+	{
+		return false;
+	}
+
+	// the properties follow the same block as an explicit grid
+	vtkSmartPointer<vtkImageData> imageData = vtkSmartPointer<vtkImageData>::New();
+	imageData->SetExtent(static_cast<int>(_initIIndex), static_cast<int>(_maxIIndex), static_cast<int>(_initJIndex), static_cast<int>(_maxJIndex), static_cast<int>(_initKIndex), static_cast<int>(_maxKIndex));
+	imageData->SetOrigin(origin[0] + xOffset, origin[1] + yOffset, (origin[2] + zOffset) * zIndice);
+	imageData->SetSpacing(spacing.data());
+	imageData->SetDirectionMatrix(axes[0][0], axes[1][0], axes[2][0],
+								  axes[0][1], axes[1][1], axes[2][1],
+								  axes[0][2], axes[1][2], axes[2][2]);
+	const bool *enabledCells = getEnabledCells();
+	addCellGhostArray(imageData, enabledCells);
+
+	_vtkData->SetPartition(0, imageData);
+	_vtkData->Modified();
+	return true;
+}
+
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::loadStructuredGrid(vtkPoints *gridPoints)
+{
+	vtkSmartPointer<vtkStructuredGrid> structuredGrid = vtkSmartPointer<vtkStructuredGrid>::New();
+	structuredGrid->SetExtent(static_cast<int>(_initIIndex), static_cast<int>(_maxIIndex), static_cast<int>(_initJIndex), static_cast<int>(_maxJIndex), static_cast<int>(_initKIndex), static_cast<int>(_maxKIndex));
+
+	// the points hold whole K interfaces from the first one of the block: they are used as is for a block spanning the whole grid
+	const uint64_t pillarICount = static_cast<uint64_t>(_iCellCount) + 1;
+	const uint64_t kInterfaceNodeCount = pillarICount * (static_cast<uint64_t>(_jCellCount) + 1);
+	const uint64_t blockNodeCount = (static_cast<uint64_t>(_maxIIndex - _initIIndex) + 1) * (_maxJIndex - _initJIndex + 1) * (_maxKIndex - _initKIndex + 1);
+	if (gridPoints->GetNumberOfPoints() == static_cast<vtkIdType>(blockNodeCount))
+	{
+		structuredGrid->SetPoints(gridPoints);
+	}
+	else
+	{
+		// the subrepresentations keep sharing the points of the whole K interfaces
+		vtkSmartPointer<vtkPoints> blockPoints = vtkSmartPointer<vtkPoints>::New();
+		blockPoints->SetDataType(gridPoints->GetDataType());
+		blockPoints->SetNumberOfPoints(blockNodeCount);
+		vtkDataArray *sourceData = gridPoints->GetData();
+		vtkDataArray *blockData = blockPoints->GetData();
+		vtkIdType blockNodeIndex = 0;
+		for (uint64_t kInterface = 0; kInterface <= _maxKIndex - _initKIndex; ++kInterface)
+		{
+			for (uint64_t jPillar = _initJIndex; jPillar <= _maxJIndex; ++jPillar)
+			{
+				for (uint64_t iPillar = _initIIndex; iPillar <= _maxIIndex; ++iPillar)
+				{
+					blockData->SetTuple(blockNodeIndex++, kInterface * kInterfaceNodeCount + jPillar * pillarICount + iPillar, sourceData);
+				}
+			}
+		}
+		structuredGrid->SetPoints(blockPoints);
+	}
+	addLocalOrigin(structuredGrid);
+
+	const bool *enabledCells = getEnabledCells();
+	addCellGhostArray(structuredGrid, enabledCells);
+
+	_vtkData->SetPartition(0, structuredGrid);
+	_vtkData->Modified();
+}
+
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::loadCoarsenedGrid()
+{
+	const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
+	const uint64_t kInterfaceNodeCount = ijkGrid->getXyzPointCountOfKInterface();
+	const std::vector<uint64_t> topKInterface = getTopKInterfaces();
+	const bool readKInterfaces = _isHyperslabed && !ijkGrid->isNodeGeometryCompressed();
+
+	// all the points when the K interfaces cannot be read one by one (it resets the block to the whole grid)
+	vtkSmartPointer<vtkPoints> allPoints = readKInterfaces ? nullptr : getVtkPoints();
+
+	// the coarse cells whose first fine cell is in the block of the process
+	const uint32_t initICoarseIndex = getCoarseIndex(_initIIndex);
+	const uint32_t maxICoarseIndex = getCoarseIndex(_maxIIndex);
+	const uint32_t initJCoarseIndex = getCoarseIndex(_initJIndex);
+	const uint32_t maxJCoarseIndex = getCoarseIndex(_maxJIndex);
+	const uint32_t initKCoarseIndex = getCoarseIndex(_initKIndex);
+	const uint32_t maxKCoarseIndex = getCoarseIndex(_maxKIndex);
+	if (initICoarseIndex >= maxICoarseIndex || initJCoarseIndex >= maxJCoarseIndex || initKCoarseIndex >= maxKCoarseIndex)
+	{
+		// a process without any coarse cell (e.g. an empty block): nothing to read
+		_vtkData->SetPartition(0, vtkSmartPointer<vtkExplicitStructuredGrid>::New());
+		_vtkData->Modified();
+		return;
+	}
+	const auto getLastFineIndex = [this](uint32_t coarseIndex, uint32_t fineCount) -> uint32_t
+	{
+		return (std::min)((coarseIndex + 1) * _stride, fineCount) - 1;
+	};
+
+	// only the K interfaces at the top and at the bottom of the coarse layers
+	std::vector<uint64_t> kInterfaces;
+	for (uint32_t kCoarseIndex = initKCoarseIndex; kCoarseIndex < maxKCoarseIndex; ++kCoarseIndex)
+	{
+		kInterfaces.push_back(topKInterface[kCoarseIndex * _stride]);
+		kInterfaces.push_back(topKInterface[getLastFineIndex(kCoarseIndex, _kCellCount)] + 1);
+	}
+	std::sort(kInterfaces.begin(), kInterfaces.end());
+	kInterfaces.erase(std::unique(kInterfaces.begin(), kInterfaces.end()), kInterfaces.end());
+	const auto getNodeOffset = [&](uint64_t kInterface) -> vtkIdType
+	{
+		return readKInterfaces
+				   ? kInterfaceNodeCount * (std::lower_bound(kInterfaces.begin(), kInterfaces.end(), kInterface) - kInterfaces.begin())
+				   : kInterfaceNodeCount * kInterface;
+	};
+
+	vtkSmartPointer<vtkExplicitStructuredGrid> vtk_explicitStructuredGrid = vtkSmartPointer<vtkExplicitStructuredGrid>::New();
+	vtk_explicitStructuredGrid->SetExtent(static_cast<int>(initICoarseIndex), static_cast<int>(maxICoarseIndex),
+										  static_cast<int>(initJCoarseIndex), static_cast<int>(maxJCoarseIndex),
+										  static_cast<int>(initKCoarseIndex), static_cast<int>(maxKCoarseIndex));
+	if (readKInterfaces)
+	{
+		ScopedTimer timer(_loadingStatistics.pointsTime);
+		double xOffset = .0;
+		double yOffset = .0;
+		double zOffset = .0;
+		double zIndice = 1.;
+		const bool isCrsValid = getCrsTransformation(xOffset, yOffset, zOffset, zIndice);
+		if (!isCrsValid)
+		{
+			vtkOutputWindowDisplayWarningText("The CRS doesn't exist or is partial");
+		}
+
+		vtkSmartPointer<vtkDoubleArray> vtkUnderlyingArray = vtkSmartPointer<vtkDoubleArray>::New();
+		vtkUnderlyingArray->SetNumberOfComponents(3);
+		vtkUnderlyingArray->SetNumberOfTuples(kInterfaces.size() * kInterfaceNodeCount);
+		for (size_t interfaceIndex = 0; interfaceIndex < kInterfaces.size(); ++interfaceIndex)
+		{
+			double *kInterfaceXyzPoints = vtkUnderlyingArray->GetPointer(0) + interfaceIndex * kInterfaceNodeCount * 3;
+			const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->getXyzPointsOfKInterface(kInterfaces[interfaceIndex], kInterfaceXyzPoints);
+			recordReading(kInterfaceNodeCount * 3, sizeof(double));
+			if (!isCrsValid)
+			{
+				zIndice = kInterfaceXyzPoints[2] > 0 ? -1. : 1.;
+			}
+			transformPoints(kInterfaceXyzPoints, kInterfaceNodeCount, xOffset, yOffset, zOffset, zIndice);
+		}
+		initLocalOriginFromFirstKInterface(kInterfaces.front() == 0 ? vtkUnderlyingArray->GetPointer(0) : nullptr);
+		vtkSmartPointer<vtkPoints> coarsePoints = vtkSmartPointer<vtkPoints>::New();
+		coarsePoints->SetData(createPointsData(vtkUnderlyingArray));
+		vtk_explicitStructuredGrid->SetPoints(coarsePoints);
+	}
+	else
+	{
+		vtk_explicitStructuredGrid->SetPoints(allPoints);
+	}
+	addLocalOrigin(vtk_explicitStructuredGrid);
+
+	// Index, within a K interface, of the 4 corner nodes of each coarse column: the corners of the fine columns at its corners
+	const uint32_t iCoarseCount = maxICoarseIndex - initICoarseIndex;
+	const uint64_t coarseColumnCount = static_cast<uint64_t>(iCoarseCount) * (maxJCoarseIndex - initJCoarseIndex);
+	std::vector<uint64_t> columnCorners(coarseColumnCount * 4);
+	const bool hasSplitNodes = ijkGrid->getSplitCoordinateLineCount() > 0;
+	if (hasSplitNodes)
+	{
+		const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->loadSplitInformation();
+	}
+	const uint64_t pillarICount = static_cast<uint64_t>(_iCellCount) + 1;
+	uint64_t columnIndex = 0;
+	for (uint32_t jCoarseIndex = initJCoarseIndex; jCoarseIndex < maxJCoarseIndex; ++jCoarseIndex)
+	{
+		const uint32_t firstJ = jCoarseIndex * _stride;
+		const uint32_t lastJ = getLastFineIndex(jCoarseIndex, _jCellCount);
+		for (uint32_t iCoarseIndex = initICoarseIndex; iCoarseIndex < maxICoarseIndex; ++iCoarseIndex)
+		{
+			const uint32_t firstI = iCoarseIndex * _stride;
+			const uint32_t lastI = getLastFineIndex(iCoarseIndex, _iCellCount);
+			uint64_t *corners = columnCorners.data() + columnIndex * 4;
+			if (hasSplitNodes)
+			{
+				// the split nodes do not depend on the K layer: the first one gives the indices within a K interface
+				corners[0] = ijkGrid->getXyzPointIndexFromCellCorner(firstI, firstJ, 0, 0);
+				corners[1] = ijkGrid->getXyzPointIndexFromCellCorner(lastI, firstJ, 0, 1);
+				corners[2] = ijkGrid->getXyzPointIndexFromCellCorner(lastI, lastJ, 0, 2);
+				corners[3] = ijkGrid->getXyzPointIndexFromCellCorner(firstI, lastJ, 0, 3);
+			}
+			else
+			{
+				corners[0] = firstI + firstJ * pillarICount;
+				corners[1] = lastI + 1 + firstJ * pillarICount;
+				corners[2] = lastI + 1 + (lastJ + 1) * pillarICount;
+				corners[3] = firstI + (lastJ + 1) * pillarICount;
+			}
+			++columnIndex;
+		}
+	}
+	if (hasSplitNodes)
+	{
+		const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->unloadSplitInformation();
+	}
+
+	// a coarse cell is hidden if one of the fine cells giving its corners has no geometry
+	const bool *enabledCells = getEnabledCells();
+	const auto isEnabled = [&](uint32_t iCellIndex, uint32_t jCellIndex, uint32_t kCellIndex) -> bool
+	{
+		return enabledCells[(static_cast<uint64_t>(kCellIndex) * _jCellCount + jCellIndex) * _iCellCount + iCellIndex];
+	};
+	{
+		FesapiUnlock fesapiUnlock;
+		for (uint32_t kCoarseIndex = initKCoarseIndex; kCoarseIndex < maxKCoarseIndex; ++kCoarseIndex)
+		{
+			const uint32_t firstK = kCoarseIndex * _stride;
+			const uint32_t lastK = getLastFineIndex(kCoarseIndex, _kCellCount);
+			const vtkIdType topOffset = getNodeOffset(topKInterface[firstK]);
+			const vtkIdType bottomOffset = getNodeOffset(topKInterface[lastK] + 1);
+			columnIndex = 0;
+			for (uint32_t jCoarseIndex = initJCoarseIndex; jCoarseIndex < maxJCoarseIndex; ++jCoarseIndex)
+			{
+				const uint32_t firstJ = jCoarseIndex * _stride;
+				const uint32_t lastJ = getLastFineIndex(jCoarseIndex, _jCellCount);
+				for (uint32_t iCoarseIndex = initICoarseIndex; iCoarseIndex < maxICoarseIndex; ++iCoarseIndex, ++columnIndex)
+				{
+					const uint32_t firstI = iCoarseIndex * _stride;
+					const uint32_t lastI = getLastFineIndex(iCoarseIndex, _iCellCount);
+					const vtkIdType cellId = vtk_explicitStructuredGrid->ComputeCellId(iCoarseIndex, jCoarseIndex, kCoarseIndex);
+					if (isEnabled(firstI, firstJ, firstK) && isEnabled(lastI, firstJ, firstK) && isEnabled(lastI, lastJ, firstK) && isEnabled(firstI, lastJ, firstK) &&
+						isEnabled(firstI, firstJ, lastK) && isEnabled(lastI, firstJ, lastK) && isEnabled(lastI, lastJ, lastK) && isEnabled(firstI, lastJ, lastK))
+					{
+						vtkIdType *indice = vtk_explicitStructuredGrid->GetCellPoints(cellId);
+						const uint64_t *corners = columnCorners.data() + columnIndex * 4;
+						for (unsigned int corner = 0; corner < 4; ++corner)
+						{
+							indice[corner] = corners[corner] + topOffset;
+							indice[corner + 4] = corners[corner] + bottomOffset;
+						}
+					}
+					else
+					{
+						vtk_explicitStructuredGrid->BlankCell(cellId);
+					}
+				}
+			}
+		}
+
+		vtk_explicitStructuredGrid->CheckAndReorderFaces();
+		vtk_explicitStructuredGrid->ComputeFacesConnectivityFlagsArray();
+	}
 
 	_vtkData->SetPartition(0, vtk_explicitStructuredGrid);
 	_vtkData->Modified();
 }
 
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::loadSurface()
+{
+	// the points first: they may reset the block to the whole grid
+	vtkSmartPointer<vtkPoints> gridPoints = getVtkPoints();
+	const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
+	const uint64_t kInterfaceNodeCount = ijkGrid->getXyzPointCountOfKInterface();
+	const std::vector<uint64_t> topKInterface = getTopKInterfaces();
+	const uint64_t translatePoint = _initKIndex < _kCellCount ? kInterfaceNodeCount * topKInterface[_initKIndex] : 0;
+	const bool *enabledCells = getEnabledCells();
+	const auto isEnabled = [&](uint32_t iCellIndex, uint32_t jCellIndex, uint32_t kCellIndex) -> bool
+	{
+		return enabledCells[(static_cast<uint64_t>(kCellIndex) * _jCellCount + jCellIndex) * _iCellCount + iCellIndex];
+	};
+
+	// the faces of the cells owned by the process, compared to the ones of their neighbours (possibly in another block)
+	const uint32_t initIIndex = ghostLevels > 0 ? ownedBlock[0] : _initIIndex;
+	const uint32_t maxIIndex = ghostLevels > 0 ? ownedBlock[1] : _maxIIndex;
+	const uint32_t initJIndex = ghostLevels > 0 ? ownedBlock[2] : _initJIndex;
+	const uint32_t maxJIndex = ghostLevels > 0 ? ownedBlock[3] : _maxJIndex;
+	const uint32_t initKIndex = ghostLevels > 0 ? ownedBlock[4] : _initKIndex;
+	const uint32_t maxKIndex = ghostLevels > 0 ? ownedBlock[5] : _maxKIndex;
+	const uint32_t initINeighbourIndex = initIIndex > 0 ? initIIndex - 1 : 0;
+	const uint32_t maxINeighbourIndex = (std::min)(maxIIndex + 1, _iCellCount);
+	const uint32_t initJNeighbourIndex = initJIndex > 0 ? initJIndex - 1 : 0;
+	const uint32_t maxJNeighbourIndex = (std::min)(maxJIndex + 1, _jCellCount);
+	const uint32_t neighbourICount = maxINeighbourIndex - initINeighbourIndex;
+
+	const bool hasSplitNodes = ijkGrid->getSplitCoordinateLineCount() > 0;
+	if (hasSplitNodes)
+	{
+		const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->loadSplitInformation();
+	}
+
+	vtkSmartPointer<vtkCellArray> faces = vtkSmartPointer<vtkCellArray>::New();
+	vtkSmartPointer<vtkIdTypeArray> originalCellIds = vtkSmartPointer<vtkIdTypeArray>::New();
+	originalCellIds->SetName("vtkOriginalCellIds");
+	surfaceCellIds = vtkSmartPointer<vtkIdList>::New();
+	// the 4 corner nodes of each column of the block and of its neighbours, within a K interface (fesapi resolves the split nodes)
+	const std::vector<uint64_t> columnCorners = getColumnCorners(initINeighbourIndex, maxINeighbourIndex, initJNeighbourIndex, maxJNeighbourIndex,
+																  hasSplitNodes ? kInterfaceNodeCount * topKInterface[_initKIndex] : 0);
+	if (hasSplitNodes)
+	{
+		const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->unloadSplitInformation();
+	}
+
+	{
+		// the corners are in memory: the faces are built without holding the fesapi lock
+		FesapiUnlock fesapiUnlock;
+		const auto getCorners = [&](uint32_t iCellIndex, uint32_t jCellIndex) -> const uint64_t *
+		{
+			return columnCorners.data() + (static_cast<uint64_t>(jCellIndex - initJNeighbourIndex) * neighbourICount + iCellIndex - initINeighbourIndex) * 4;
+		};
+
+		// corners of each face of a cell (0 to 3 at the top, 4 to 7 at the bottom) in the order -I, +I, -J, +J, -K, +K
+		const unsigned int faceCorners[6][4] = { { 0, 3, 7, 4 }, { 1, 5, 6, 2 }, { 0, 4, 5, 1 }, { 3, 2, 6, 7 }, { 0, 1, 2, 3 }, { 4, 7, 6, 5 } };
+		for (uint32_t kCellIndex = initKIndex; kCellIndex < maxKIndex; ++kCellIndex)
+		{
+			const vtkIdType topOffset = kInterfaceNodeCount * topKInterface[kCellIndex] - translatePoint;
+			const vtkIdType bottomOffset = topOffset + kInterfaceNodeCount;
+			for (uint32_t jCellIndex = initJIndex; jCellIndex < maxJIndex; ++jCellIndex)
+			{
+				for (uint32_t iCellIndex = initIIndex; iCellIndex < maxIIndex; ++iCellIndex)
+				{
+					if (!isEnabled(iCellIndex, jCellIndex, kCellIndex))
+					{
+						continue;
+					}
+					const uint64_t *corners = getCorners(iCellIndex, jCellIndex);
+
+					// a face is on the boundary without neighbour cell, with an inactive one or when their nodes differ (fault or K gap)
+					bool isBoundary[6];
+					isBoundary[0] = iCellIndex == 0 || !isEnabled(iCellIndex - 1, jCellIndex, kCellIndex) ||
+									getCorners(iCellIndex - 1, jCellIndex)[1] != corners[0] || getCorners(iCellIndex - 1, jCellIndex)[2] != corners[3];
+					isBoundary[1] = iCellIndex + 1 == _iCellCount || !isEnabled(iCellIndex + 1, jCellIndex, kCellIndex) ||
+									getCorners(iCellIndex + 1, jCellIndex)[0] != corners[1] || getCorners(iCellIndex + 1, jCellIndex)[3] != corners[2];
+					isBoundary[2] = jCellIndex == 0 || !isEnabled(iCellIndex, jCellIndex - 1, kCellIndex) ||
+									getCorners(iCellIndex, jCellIndex - 1)[3] != corners[0] || getCorners(iCellIndex, jCellIndex - 1)[2] != corners[1];
+					isBoundary[3] = jCellIndex + 1 == _jCellCount || !isEnabled(iCellIndex, jCellIndex + 1, kCellIndex) ||
+									getCorners(iCellIndex, jCellIndex + 1)[0] != corners[3] || getCorners(iCellIndex, jCellIndex + 1)[1] != corners[2];
+					isBoundary[4] = kCellIndex == 0 || !isEnabled(iCellIndex, jCellIndex, kCellIndex - 1) ||
+									topKInterface[kCellIndex - 1] + 1 != topKInterface[kCellIndex];
+					isBoundary[5] = kCellIndex + 1 == _kCellCount || !isEnabled(iCellIndex, jCellIndex, kCellIndex + 1) ||
+									topKInterface[kCellIndex] + 1 != topKInterface[kCellIndex + 1];
+
+					const vtkIdType globalCellId = (static_cast<vtkIdType>(kCellIndex) * _jCellCount + jCellIndex) * _iCellCount + iCellIndex;
+					const vtkIdType blockCellId = (static_cast<vtkIdType>(kCellIndex - _initKIndex) * (_maxJIndex - _initJIndex) + jCellIndex - _initJIndex) * (_maxIIndex - _initIIndex) + iCellIndex - _initIIndex;
+					for (unsigned int face = 0; face < 6; ++face)
+					{
+						if (isBoundary[face])
+						{
+							vtkIdType faceNodes[4];
+							for (unsigned int faceCorner = 0; faceCorner < 4; ++faceCorner)
+							{
+								const unsigned int corner = faceCorners[face][faceCorner];
+								faceNodes[faceCorner] = corners[corner % 4] + (corner < 4 ? topOffset : bottomOffset);
+							}
+							faces->InsertNextCell(4, faceNodes);
+							originalCellIds->InsertNextValue(globalCellId);
+							surfaceCellIds->InsertNextId(blockCellId);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	vtkSmartPointer<vtkPolyData> surface = vtkSmartPointer<vtkPolyData>::New();
+	surface->SetPoints(gridPoints);
+	surface->SetPolys(faces);
+	surface->GetCellData()->AddArray(originalCellIds);
+	addLocalOrigin(surface);
+
+	_vtkData->SetPartition(0, surface);
+	_vtkData->Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkDataArray> ResqmlIjkGridToVtkExplicitStructuredGrid::mapCellValues(vtkDataArray *p_cellValues) const
+{
+	if (surfaceCellIds == nullptr)
+	{
+		return p_cellValues;
+	}
+
+	// the values of the cell of each face
+	vtkSmartPointer<vtkDataArray> faceValues = vtkSmartPointer<vtkDataArray>::Take(p_cellValues->NewInstance());
+	faceValues->SetName(p_cellValues->GetName());
+	faceValues->SetNumberOfComponents(p_cellValues->GetNumberOfComponents());
+	faceValues->SetNumberOfTuples(surfaceCellIds->GetNumberOfIds());
+	p_cellValues->GetTuples(surfaceCellIds, faceValues);
+	return faceValues;
+}
+
 //----------------------------------------------------------------------------
 vtkSmartPointer<vtkPoints> ResqmlIjkGridToVtkExplicitStructuredGrid::getVtkPoints()
 {
@@ -186,10 +994,12 @@ vtkSmartPointer<vtkPoints> ResqmlIjkGridToVtkExplicitStructuredGrid::getVtkPoint
 //----------------------------------------------------------------------------
 void ResqmlIjkGridToVtkExplicitStructuredGrid::createPoints()
 {
+	ScopedTimer timer(_loadingStatistics.pointsTime);
 	const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
 
-	this->points->SetNumberOfPoints(_pointCount);
-	size_t point_id = 0;
+	// the points are read and transformed in place in an array adopted by the vtkPoints without copy
+	vtkSmartPointer<vtkDoubleArray> vtkUnderlyingArray = vtkSmartPointer<vtkDoubleArray>::New();
+	vtkUnderlyingArray->SetNumberOfComponents(3);
 
 	if (_isHyperslabed && !ijkGrid->isNodeGeometryCompressed())
 	{
@@ -219,56 +1029,159 @@ void ResqmlIjkGridToVtkExplicitStructuredGrid::createPoints()
 			}
 		}
 
+		// the CRS is the same for all the K interfaces
+		double xOffset = .0;
+		double yOffset = .0;
+		double zOffset = .0;
+		double zIndice = 1.;
+		const bool isCrsValid = getCrsTransformation(xOffset, yOffset, zOffset, zIndice);
+		if (!isCrsValid)
+		{
+			vtkOutputWindowDisplayWarningText("The CRS doesn't exist or is partial");
+		}
+
+		// only the K interfaces of the block are read
 		const uint64_t kInterfaceNodeCount = ijkGrid->getXyzPointCountOfKInterface();
-		std::unique_ptr<double[]> allXyzPoints(new double[kInterfaceNodeCount * 3]);
+		const uint32_t kInterfaceCount = maxKInterfaceIndex - initKInterfaceIndex + 1;
+		vtkUnderlyingArray->SetNumberOfTuples(kInterfaceCount * kInterfaceNodeCount);
+		double *allXyzPoints = vtkUnderlyingArray->GetPointer(0);
 
-		for (uint_fast32_t kInterface = initKInterfaceIndex; kInterface <= maxKInterfaceIndex; ++kInterface)
+		// a single worker transforms the K interfaces already read while fesapi reads the next ones
+		std::vector<double> zIndices(kInterfaceCount, zIndice);
+		std::mutex readMutex;
+		std::condition_variable readCondition;
+		uint32_t readCount = 0;
+		bool isReadingOver = false;
+		std::thread transformation([&]() -> void
 		{
-			const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->getXyzPointsOfKInterface(kInterface, allXyzPoints.get());
-			auto const *crs = ijkGrid->getLocalCrs(0);
-			double xOffset = .0;
-			double yOffset = .0;
-			double zOffset = .0;
-			double zIndice = allXyzPoints[2] > 0 ? -1. : 1.;
-			if (crs != nullptr && !crs->isPartial())
+			uint32_t transformedCount = 0;
+			while (true)
 			{
-				xOffset = crs->getOriginOrdinal1();
-				yOffset = crs->getOriginOrdinal2();
-				auto const *depthCrs = dynamic_cast<RESQML2_NS::LocalDepth3dCrs const *>(crs);
-				zOffset = depthCrs != nullptr ? depthCrs->getOriginDepthOrElevation() : 0;
-				zIndice = crs->isDepthOriented() ? -1. : 1.;
+				uint32_t availableCount = 0;
+				{
+					std::unique_lock<std::mutex> lock(readMutex);
+					readCondition.wait(lock, [&]() -> bool { return isReadingOver || readCount > transformedCount; });
+					availableCount = readCount;
+				}
+				if (availableCount == transformedCount)
+				{
+					return;
+				}
+				for (; transformedCount < availableCount; ++transformedCount)
+				{
+					transformPoints(allXyzPoints + transformedCount * kInterfaceNodeCount * 3, kInterfaceNodeCount, xOffset, yOffset, zOffset, zIndices[transformedCount]);
+				}
 			}
-			else
+		});
+		const auto stopTransformation = [&]() -> void
+		{
 			{
-				vtkOutputWindowDisplayWarningText("The CRS doesn't exist or is partial");
+				std::lock_guard<std::mutex> lock(readMutex);
+				isReadingOver = true;
 			}
-			for (uint_fast64_t nodeIndex = 0; nodeIndex < kInterfaceNodeCount * 3; nodeIndex += 3)
+			readCondition.notify_one();
+			transformation.join();
+		};
+
+		try
+		{
+			for (uint32_t kInterfaceIndex = 0; kInterfaceIndex < kInterfaceCount; ++kInterfaceIndex)
 			{
-				this->points->SetPoint(point_id++, allXyzPoints[nodeIndex] + xOffset, allXyzPoints[nodeIndex + 1] + yOffset, (allXyzPoints[nodeIndex + 2] + zOffset) * zIndice);
+				double *kInterfaceXyzPoints = allXyzPoints + kInterfaceIndex * kInterfaceNodeCount * 3;
+				const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->getXyzPointsOfKInterface(initKInterfaceIndex + kInterfaceIndex, kInterfaceXyzPoints);
+				recordReading(kInterfaceNodeCount * 3, sizeof(double));
+				if (!isCrsValid)
+				{
+					zIndices[kInterfaceIndex] = kInterfaceXyzPoints[2] > 0 ? -1. : 1.;
+				}
+
+				{
+					std::lock_guard<std::mutex> lock(readMutex);
+					++readCount;
+				}
+				readCondition.notify_one();
 			}
 		}
+		catch (...)
+		{
+			stopTransformation();
+			throw;
+		}
+		stopTransformation();
+		initLocalOriginFromFirstKInterface(initKInterfaceIndex == 0 ? allXyzPoints : nullptr);
 	}
 	else
 	{
+		// the whole grid
+		_initIIndex = 0;
+		_maxIIndex = _iCellCount;
+		_initJIndex = 0;
+		_maxJIndex = _jCellCount;
 		_initKIndex = 0;
 		_maxKIndex = _kCellCount;
 
-		std::unique_ptr<double[]> allXyzPoints(new double[_pointCount * 3]);
+		vtkUnderlyingArray->SetNumberOfTuples(_pointCount);
+		double *allXyzPoints = vtkUnderlyingArray->GetPointer(0);
 		auto const *crs = ijkGrid->getLocalCrs(0);
 		if (crs != nullptr && !crs->isPartial())
 		{
-			ijkGrid->getXyzPointsOfAllPatchesInGlobalCrs(allXyzPoints.get());
-			const size_t coordCount = _pointCount * 3;
+			ijkGrid->getXyzPointsOfAllPatchesInGlobalCrs(allXyzPoints);
+			recordReading(_pointCount * 3, sizeof(double));
 
-			const double zIndice = ijkGrid->getLocalCrs(0)->isDepthOriented() ? -1 : 1;
-			for (uint_fast64_t pointIndex = 0; pointIndex < coordCount; pointIndex += 3)
-			{
-				this->points->SetPoint(point_id++, allXyzPoints[pointIndex], allXyzPoints[pointIndex + 1], -allXyzPoints[pointIndex + 2] * zIndice);
-			}
+			const double zIndice = crs->isDepthOriented() ? -1 : 1;
+			transformPoints(allXyzPoints, _pointCount, .0, .0, .0, -zIndice);
 		}
 		else
 		{
 			vtkOutputWindowDisplayWarningText("The CRS doesn't exist or is partial");
+			vtkUnderlyingArray->Fill(.0);
 		}
 	}
+
+	this->points->SetData(createPointsData(vtkUnderlyingArray));
+}
+
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::initLocalOriginFromFirstKInterface(const double *firstKInterfaceXyzPoints)
+{
+	if (!_singlePrecision || _hasLocalOrigin)
+	{
+		return;
+	}
+
+	const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid = getResqmlData();
+	const uint64_t kInterfaceNodeCount = ijkGrid->getXyzPointCountOfKInterface();
+	std::unique_ptr<double[]> kInterfaceXyzPoints;
+	if (firstKInterfaceXyzPoints == nullptr)
+	{
+		double xOffset = .0;
+		double yOffset = .0;
+		double zOffset = .0;
+		double zIndice = 1.;
+		const bool isCrsValid = getCrsTransformation(xOffset, yOffset, zOffset, zIndice);
+
+		kInterfaceXyzPoints.reset(new double[kInterfaceNodeCount * 3]);
+		const_cast<RESQML2_NS::AbstractIjkGridRepresentation *>(ijkGrid)->getXyzPointsOfKInterface(0, kInterfaceXyzPoints.get());
+		recordReading(kInterfaceNodeCount * 3, sizeof(double), kInterfaceNodeCount * 3 * sizeof(double));
+		if (!isCrsValid)
+		{
+			zIndice = kInterfaceXyzPoints[2] > 0 ? -1. : 1.;
+		}
+		transformPoints(kInterfaceXyzPoints.get(), kInterfaceNodeCount, xOffset, yOffset, zOffset, zIndice);
+		firstKInterfaceXyzPoints = kInterfaceXyzPoints.get();
+	}
+	initLocalOrigin(firstKInterfaceXyzPoints, static_cast<vtkIdType>(kInterfaceNodeCount));
+}
+
+//----------------------------------------------------------------------------
+void ResqmlIjkGridToVtkExplicitStructuredGrid::transformPoints(double *xyzPoints, uint64_t pointCount, double xOffset, double yOffset, double zOffset, double zIndice)
+{
+	// a single branchless pass the compiler can vectorize
+	const uint64_t coordCount = pointCount * 3;
+	for (uint64_t coordIndex = 0; coordIndex < coordCount; coordIndex += 3)
+	{
+		xyzPoints[coordIndex] += xOffset;
+		xyzPoints[coordIndex + 1] += yOffset;
+		xyzPoints[coordIndex + 2] = (xyzPoints[coordIndex + 2] + zOffset) * zIndice;
+	}
 }
@@ -20,14 +20,21 @@ under the License.
 #define __ResqmlIjkGridToVtkExplicitStructuredGrid__h__
 
 /** @brief	transform a resqml ijkGrid representation to vtkExplicitStructuredGrid
+ * (vtkImageData for a regular lattice, vtkStructuredGrid without split node nor K gap)
  */
 
 // include system
+#include <array>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 // include VTK
 #include <vtkSmartPointer.h>
 #include <vtkPoints.h>
+#include <vtkDataSet.h>
+#include <vtkIdList.h>
 
 #include "ResqmlAbstractRepresentationToVtkPartitionedDataSet.h"
 
@@ -41,14 +48,30 @@ class ResqmlIjkGridToVtkExplicitStructuredGrid : public ResqmlAbstractRepresenta
 public:
 	/**
 	 * Constructor
+	 * @param p_ghostLevels	number of cell layers loaded around the block of the process (distributed grid only)
+	 * @param p_hyperslabingCapacities	capacity of the already checked grids (by uuid), owned by the caller; nullptr to check it for this grid only
 	 */
-	explicit ResqmlIjkGridToVtkExplicitStructuredGrid(const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid, uint32_t p_procNumber = 0, uint32_t p_maxProc = 1);
+	explicit ResqmlIjkGridToVtkExplicitStructuredGrid(const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid, uint32_t p_procNumber = 0, uint32_t p_maxProc = 1, uint32_t p_ghostLevels = 0,
+													  std::unordered_map<std::string, bool> *p_hyperslabingCapacities = nullptr);
 
 	/**
 	 * load vtkDataSet with resqml data
 	 */
 	void loadVtkObject() override;
 
+	/**
+	 * Load a coarsened preview made of a cell every stride cells along each axis (1 loads the full resolution).
+	 * Only the K interfaces bounding the coarse layers and the first K layer of each coarse layer of the cell properties are read.
+	 */
+	void setStride(uint32_t stride);
+
+	/**
+	 * Load only the boundary faces of the cells as a vtkPolyData: the outer shell and the faces exposed by the inactive cells,
+	 * the faults and the K gaps. The cell properties are given for each face from its cell ("vtkOriginalCellIds" cell array).
+	 * A coarsened preview (see setStride) takes precedence.
+	 */
+	void setSurfaceOnly(bool surface) { surfaceOnly = surface; }
+
 	/**
 	 * Create the VTK points from the RESQML points of the RESQML IJK grid representation.
 	 */
@@ -59,17 +82,118 @@ public:
 	 */
 	vtkSmartPointer<vtkPoints> getVtkPoints();
 
+	/**
+	 * @return the memory (in kibibytes) of the points already created, without creating them
+	 */
+	unsigned long getPointsMemorySize() const { return points->GetActualMemorySize(); }
+
 protected:
 	const RESQML2_NS::AbstractIjkGridRepresentation *getResqmlData() const;
+	/**
+	 * Translate the points of a K interface (or of the whole grid) by the CRS origin and orient their Z axis, in place.
+	 */
+	static void transformPoints(double *xyzPoints, uint64_t pointCount, double xOffset, double yOffset, double zOffset, double zIndice);
 	vtkSmartPointer<vtkPoints> points;
 
 	uint32_t pointer_on_points;
 
+	// block of the cells owned by the process (i, j and k ranges): the other loaded cells are ghost cells
+	uint32_t ghostLevels;
+	std::array<uint32_t, 6> ownedBlock;
+
+	// surface mode: index, within the block, of the cell of each face
+	bool surfaceOnly;
+	vtkSmartPointer<vtkIdList> surfaceCellIds;
+
+	// if the geometry of each cell of the grid is defined (see getEnabledCells)
+	std::unique_ptr<bool[]> cellGeometryIsDefined;
+
 	/**
 	 * method : checkHyperslabingCapacity
 	 * variable : ijkGridRepresentation
-	 * check if an ijkgrid is Hyperslabed
+	 * check if an ijkgrid is Hyperslabed (from the kind of its geometry, looked up in and added to hyperslabingCapacities if any)
+	 */
+	void checkHyperslabingCapacity(const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid, std::unordered_map<std::string, bool> *hyperslabingCapacities);
+
+	/**
+	 * Get the translation and the Z orientation of the local CRS of the grid.
+	 * @return false if the CRS does not exist or is partial
+	 */
+	bool getCrsTransformation(double &xOffset, double &yOffset, double &zOffset, double &zIndice) const;
+
+	/**
+	 * In single precision, set the local origin at the center of the bounds of the first K interface of the grid
+	 * (translated and oriented like the hyperslabed points), so that all the pieces of the grid share the same origin.
+	 * @param firstKInterfaceXyzPoints	the transformed points of the first K interface if they are already loaded, else nullptr to read them
+	 */
+	void initLocalOriginFromFirstKInterface(const double *firstKInterfaceXyzPoints);
+
+	/**
+	 * @return the K interface at the top of each K layer, taking into account the K gaps
+	 */
+	std::vector<uint64_t> getTopKInterfaces() const;
+
+	/**
+	 * Index, within a K interface, of the 4 corner nodes of each column of an I/J range (corners 0 to 3 at the top, 4 to 7 at the bottom):
+	 * split nodes only depend on the column, never on the K layer. The split information must be loaded if there are split nodes.
+	 * @param topNodeOffset	index of the first node of the K interface at the top of the layer _initKIndex
+	 */
+	std::vector<uint64_t> getColumnCorners(uint32_t initIIndex, uint32_t maxIIndex, uint32_t initJIndex, uint32_t maxJIndex, uint64_t topNodeOffset) const;
+
+	/**
+	 * @return for each cell of the grid, if its geometry is defined (read once for the lifetime of the mapper)
+	 */
+	const bool *getEnabledCells();
+
+	/**
+	 * Hide the cells of the block without geometry and mark the ghost cells as duplicate, in the vtkGhostType array of dataSet
+	 */
+	void addCellGhostArray(vtkDataSet *dataSet, const bool *enabledCells) const;
+
+	/**
+	 * Load the grid as a vtkImageData if its geometry is a lattice of constant spacings along orthogonal axes.
+	 * @return false if the grid must be loaded with explicit points
+	 */
+	bool loadRegularLattice();
+
+	/**
+	 * Load a grid without split node nor K gap as a vtkStructuredGrid on the points of the block
+	 */
+	void loadStructuredGrid(vtkPoints *gridPoints);
+
+	/**
+	 * Load the coarsened preview of the grid (see setStride) as a vtkExplicitStructuredGrid
+	 */
+	void loadCoarsenedGrid();
+
+	/**
+	 * Load the boundary faces of the cells of the block (see setSurfaceOnly)
+	 */
+	void loadSurface();
+
+	/**
+	 * @return the values of the cell of each face in surface mode, p_cellValues otherwise
+	 */
+	vtkSmartPointer<vtkDataArray> mapCellValues(vtkDataArray *p_cellValues) const override;
+
+	/**
+	 * Compute the I/J/K block of the process: the processes are spread over the K layers first, then over J and I,
+	 * and each cut balances the cells having a geometry.
+	 */
+	void computeBlock(const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid);
+
+	/**
+	 * Spread rankCount contiguous ranks over blockCount blocks, each block getting rankCount / blockCount ranks or one more.
+	 * @param blockIndex	block of the rank
+	 * @param rankIndexInBlock	index of the rank among the ranks of its block
+	 * @param rankCountInBlock	number of ranks of the block
+	 */
+	static void spreadRanks(uint32_t rank, uint32_t rankCount, uint32_t blockCount, uint32_t &blockIndex, uint32_t &rankIndexInBlock, uint32_t &rankCountInBlock);
+
+	/**
+	 * Split [0, weights.size()) into partCount contiguous ranges of balanced weights.
+	 * [begin, end) is the range partIndex (empty if there are less indices than parts).
 	 */
-	void checkHyperslabingCapacity(const RESQML2_NS::AbstractIjkGridRepresentation *ijkGrid);
+	static void splitBalanced(const std::vector<uint64_t> &weights, uint32_t partCount, uint32_t partIndex, uint32_t &begin, uint32_t &end);
 };
 #endif
@@ -79,8 +79,9 @@ void ResqmlPolylineToVtkPolyData::loadVtkObject()
 	vtkUnderlyingArray->SetNumberOfComponents(3);
 	// Take ownership of the underlying C array
 	vtkUnderlyingArray->SetArray(allXyzPoints, coordCount, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-	vtkPts->SetData(vtkUnderlyingArray);
+	vtkPts->SetData(createPointsData(vtkUnderlyingArray));
 	vtk_polydata->SetPoints(vtkPts);
+	addLocalOrigin(vtk_polydata);
 
 	// POLYLINE
 	vtkSmartPointer<vtkCellArray> setPolylineRepresentationLines = vtkSmartPointer<vtkCellArray>::New();
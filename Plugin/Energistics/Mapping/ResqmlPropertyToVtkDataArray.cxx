@@ -19,6 +19,9 @@ under the License.
 #include "Mapping/ResqmlPropertyToVtkDataArray.h"
 #include "vtkMath.h"
 
+#include <algorithm>
+#include <memory>
+
 // FESAPI
 #include <fesapi/resqml2/CategoricalProperty.h>
 #include <fesapi/resqml2/ContinuousProperty.h>
@@ -36,6 +39,44 @@ under the License.
 #include <vtkCharArray.h>
 #include <vtkUnsignedCharArray.h>
 
+namespace
+{
+	/**
+	 * Copy the values of an I/J block from the values of whole K layers
+	 */
+	template <typename T>
+	void copyBlockValues(const T *layerValues, T *blockValues,
+						 uint32_t gridICellCount, uint32_t gridJCellCount,
+						 uint32_t iCellCount, uint32_t jCellCount, uint32_t kCellCount,
+						 uint32_t initIIndex, uint32_t initJIndex)
+	{
+		for (uint32_t kCellIndex = 0; kCellIndex < kCellCount; ++kCellIndex)
+		{
+			for (uint32_t jCellIndex = 0; jCellIndex < jCellCount; ++jCellIndex)
+			{
+				const T *row = layerValues + (static_cast<uint64_t>(kCellIndex) * gridJCellCount + initJIndex + jCellIndex) * gridICellCount + initIIndex;
+				blockValues = std::copy(row, row + iCellCount, blockValues);
+			}
+		}
+	}
+
+	/**
+	 * Copy a value every stride values along I and J from the values of a K layer
+	 */
+	template <typename T>
+	void copyStridedValues(const T *layerValues, uint64_t layerICount, T *coarseValues,
+						   uint32_t iCellCount, uint32_t jCellCount, uint32_t stride)
+	{
+		for (uint32_t jCellIndex = 0; jCellIndex < jCellCount; ++jCellIndex)
+		{
+			for (uint32_t iCellIndex = 0; iCellIndex < iCellCount; ++iCellIndex)
+			{
+				*coarseValues++ = layerValues[static_cast<uint64_t>(jCellIndex) * stride * layerICount + static_cast<uint64_t>(iCellIndex) * stride];
+			}
+		}
+	}
+}
+
 //----------------------------------------------------------------------------
 ResqmlPropertyToVtkDataArray::ResqmlPropertyToVtkDataArray(const RESQML2_NS::AbstractValuesProperty *valuesProperty,
 														   uint64_t cellCount,
@@ -43,8 +84,27 @@ ResqmlPropertyToVtkDataArray::ResqmlPropertyToVtkDataArray(const RESQML2_NS::Abs
 														   uint32_t iCellCount,
 														   uint32_t jCellCount,
 														   uint32_t kCellCount,
+														   uint32_t initIIndex,
+														   uint32_t initJIndex,
 														   uint32_t initKIndex,
-														   uint64_t patch_index)
+														   uint32_t gridICellCount,
+														   uint32_t gridJCellCount,
+														   uint64_t patch_index,
+														   uint32_t stride)
+	: dataArray(nullptr),
+	  isHyperslabed(true),
+	  singlePrecision(true),
+	  cellCount(cellCount),
+	  iCellCount(iCellCount),
+	  jCellCount(jCellCount),
+	  kCellCount(kCellCount),
+	  initIIndex(initIIndex),
+	  initJIndex(initJIndex),
+	  initKIndex(initKIndex),
+	  gridICellCount(gridICellCount),
+	  gridJCellCount(gridJCellCount),
+	  stride(stride),
+	  patchIndex(patch_index)
 {
 	uint32_t nbElement = 0;
 
@@ -69,81 +129,39 @@ ResqmlPropertyToVtkDataArray::ResqmlPropertyToVtkDataArray(const RESQML2_NS::Abs
 		vtkOutputWindowDisplayErrorText("does not support vectorial property yet\n");
 	}
 
-	const uint64_t numValuesInEachDimension = cellCount;						 // cellCount/kCellCount; //3834;//iCellCount*jCellCount*kCellCount;
-	const uint64_t offsetInEachDimension = iCellCount * jCellCount * initKIndex; // initKIndex;//iCellCount*jCellCount*initKIndex;
-
-	std::string typeProperty = valuesProperty->getXmlTag();
-	if (typeProperty == RESQML2_NS::ContinuousProperty::XML_TAG)
-	{
-		vtkSmartPointer<vtkFloatArray> cellDataFloat = vtkSmartPointer<vtkFloatArray>::New();
-		float *valuesFloatSet = new float[nbElement]; // deleted by VTK cellData vtkSmartPointer
-		if (valuesProperty->getDimensionsCountOfPatch(patch_index) == 3)
-		{
-			valuesProperty->getFloatValuesOf3dPatch(patch_index, valuesFloatSet, iCellCount, jCellCount, kCellCount, 0, 0, initKIndex);
-		}
-		else if (valuesProperty->getDimensionsCountOfPatch(patch_index) == 1)
-		{
-			valuesProperty->getFloatValuesOfPatch(patch_index, valuesFloatSet, &numValuesInEachDimension, &offsetInEachDimension, 1);
-		}
-		else
-		{
-			vtkOutputWindowDisplayErrorText("error in : propertyValue->getDimensionsCountOfPatch (values different of 1 or 3)\n");
-		}
-		cellDataFloat->SetName(valuesProperty->getTitle().c_str());
-		cellDataFloat->SetArray(valuesFloatSet, nbElement, 0, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-		this->dataArray = cellDataFloat;
-	}
-	else if (typeProperty == RESQML2_NS::DiscreteProperty::XML_TAG)
-	{
-		vtkSmartPointer<vtkIntArray> cellDataInt = vtkSmartPointer<vtkIntArray>::New();
-		int32_t *valuesIntSet = new int32_t[nbElement]; // deleted by VTK cellData vtkSmartPointer
-		if (valuesProperty->getDimensionsCountOfPatch(patch_index) == 3)
-		{
-			valuesProperty->getIntValuesOf3dPatch(patch_index, valuesIntSet, iCellCount, jCellCount, kCellCount, 0, 0, initKIndex);
-		}
-		else if (valuesProperty->getDimensionsCountOfPatch(0) == 1)
-		{
-			valuesProperty->getIntValuesOfPatch(patch_index, valuesIntSet, &numValuesInEachDimension, &offsetInEachDimension, 1);
-		}
-		else
-		{
-			vtkOutputWindowDisplayErrorText("error in : propertyValue->getDimensionsCountOfPatch (values different of 1 or 3)\n");
-		}
-		cellDataInt->SetName(valuesProperty->getTitle().c_str());
-		cellDataInt->SetArray(valuesIntSet, nbElement, 0, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-		this->dataArray = cellDataInt;
-	}
-	else if (typeProperty == RESQML2_NS::CategoricalProperty::XML_TAG)
-	{
-		vtkSmartPointer<vtkIntArray> cellDataInt = vtkSmartPointer<vtkIntArray>::New();
-		int32_t*valuesIntSet = new int32_t[nbElement]; // deleted by VTK cellData vtkSmartPointer
-		if (valuesProperty->getDimensionsCountOfPatch(patch_index) == 3)
-		{
-			valuesProperty->getIntValuesOf3dPatch(patch_index, valuesIntSet, iCellCount, jCellCount, kCellCount, 0, 0, initKIndex);
-		}
-		else if (valuesProperty->getDimensionsCountOfPatch(patch_index) == 1)
-		{
-			valuesProperty->getIntValuesOfPatch(patch_index, valuesIntSet, &numValuesInEachDimension, &offsetInEachDimension, 1);
-		}
-		else
-		{
-			vtkOutputWindowDisplayErrorText("error in : propertyValue->getDimensionsCountOfPatch (values different of 1 or 3)\n");
-		}
-		cellDataInt->SetName(valuesProperty->getTitle().c_str());
-		cellDataInt->SetArray(valuesIntSet, nbElement, 0, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-		this->dataArray = cellDataInt;
-	}
-	else
+	const int vtkDataType = getVtkDataType(valuesProperty);
+	if (vtkDataType == VTK_VOID)
 	{
 		vtkOutputWindowDisplayErrorText("property not supported...  (hdfDatatypeEnum)\n");
+		return;
 	}
+
+	this->dataArray.TakeReference(vtkDataArray::CreateDataArray(vtkDataType));
+	this->dataArray->SetNumberOfValues(nbElement);
+	readValues(valuesProperty);
+	this->dataArray->SetName(valuesProperty->getTitle().c_str());
 }
 
 // -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 ResqmlPropertyToVtkDataArray::ResqmlPropertyToVtkDataArray(resqml2::AbstractValuesProperty const *valuesProperty,
 															uint64_t cellCount,
 															uint64_t pointCount,
-															uint64_t patch_index)	
+															uint64_t patch_index,
+															bool singlePrecision)
+	: dataArray(nullptr),
+	  isHyperslabed(false),
+	  singlePrecision(singlePrecision),
+	  cellCount(cellCount),
+	  iCellCount(0),
+	  jCellCount(0),
+	  kCellCount(0),
+	  initIIndex(0),
+	  initJIndex(0),
+	  initKIndex(0),
+	  gridICellCount(0),
+	  gridJCellCount(0),
+	  stride(1),
+	  patchIndex(patch_index)
 {
 	uint64_t nbElement = 0;
 
@@ -163,40 +181,206 @@ ResqmlPropertyToVtkDataArray::ResqmlPropertyToVtkDataArray(resqml2::AbstractValu
 	}
 
 	const uint32_t elementCountPerValue = valuesProperty->getElementCountPerValue();
-	const std::string name = valuesProperty->getTitle();
-	const std::string xmlTag = valuesProperty->getXmlTag();
-	if (xmlTag == resqml2::ContinuousProperty::XML_TAG)
+	const int vtkDataType = getVtkDataType(valuesProperty);
+	if (vtkDataType == VTK_DOUBLE || vtkDataType == VTK_FLOAT)
 	{
 		const uint64_t totalHDFElementcount = nbElement * elementCountPerValue;
 		if (totalHDFElementcount != valuesProperty->getValuesCountOfPatch(patch_index))
 		{
 			throw std::invalid_argument("Property values count of hdfDataset \"" + std::to_string(valuesProperty->getValuesCountOfPatch(patch_index)) + "\" does not match the indexable element count in the supporting representation\"" + std::to_string(totalHDFElementcount) + "\"");
 		}
+	}
+	else if (vtkDataType == VTK_VOID)
+	{
+		throw std::invalid_argument("does not support property which are not discrete or categorical or continuous yet");
+	}
+
+	this->dataArray.TakeReference(vtkDataArray::CreateDataArray(vtkDataType));
+	this->dataArray->SetNumberOfComponents(elementCountPerValue);
+	this->dataArray->SetNumberOfTuples(nbElement);
+	readValues(valuesProperty);
+	this->dataArray->SetName(valuesProperty->getTitle().c_str());
+}
+
+//----------------------------------------------------------------------------
+bool ResqmlPropertyToVtkDataArray::replaceValues(const RESQML2_NS::AbstractValuesProperty *resqmlProperty)
+{
+	if (this->dataArray == nullptr ||
+		getVtkDataType(resqmlProperty) != this->dataArray->GetDataType() ||
+		static_cast<int>(resqmlProperty->getElementCountPerValue()) != this->dataArray->GetNumberOfComponents() ||
+		(!isHyperslabed && resqmlProperty->getValuesCountOfPatch(patchIndex) != static_cast<uint64_t>(this->dataArray->GetNumberOfValues())))
+	{
+		return false;
+	}
 
-		double* valuesDoubleSet = new double[totalHDFElementcount]; // deleted by VTK data vtkSmartPointer
-		valuesProperty->getDoubleValuesOfPatch(patch_index, valuesDoubleSet);
+	detachSharedArray();
+	readValues(resqmlProperty);
+	this->dataArray->Modified();
+	return true;
+}
 
-		vtkSmartPointer<vtkDoubleArray> cellDataDouble = vtkSmartPointer<vtkDoubleArray>::New();
-		cellDataDouble->SetNumberOfComponents(elementCountPerValue);
-		cellDataDouble->SetName(name.c_str());
-		cellDataDouble->SetArray(valuesDoubleSet, nbElement * elementCountPerValue, 0, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-		this->dataArray = cellDataDouble;
+//----------------------------------------------------------------------------
+void ResqmlPropertyToVtkDataArray::detachSharedArray()
+{
+	if (this->dataArray->GetReferenceCount() == 1)
+	{
+		return;
+	}
+
+	vtkSmartPointer<vtkDataArray> sharedArray = this->dataArray;
+	this->dataArray = vtkSmartPointer<vtkDataArray>::Take(sharedArray->NewInstance());
+	this->dataArray->SetName(sharedArray->GetName());
+	this->dataArray->SetNumberOfComponents(sharedArray->GetNumberOfComponents());
+	this->dataArray->SetNumberOfTuples(sharedArray->GetNumberOfTuples());
+}
+
+//----------------------------------------------------------------------------
+int ResqmlPropertyToVtkDataArray::getVtkDataType(const RESQML2_NS::AbstractValuesProperty *resqmlProperty) const
+{
+	const std::string xmlTag = resqmlProperty->getXmlTag();
+	if (xmlTag == RESQML2_NS::ContinuousProperty::XML_TAG)
+	{
+		return singlePrecision ? VTK_FLOAT : VTK_DOUBLE;
+	}
+	if (xmlTag == RESQML2_NS::DiscreteProperty::XML_TAG)
+	{
+		return VTK_INT;
+	}
+	if (xmlTag == RESQML2_NS::CategoricalProperty::XML_TAG &&
+		(isHyperslabed || static_cast<RESQML2_NS::CategoricalProperty const *>(resqmlProperty)->getStringLookup() != nullptr))
+	{
+		return VTK_INT;
+	}
+	return VTK_VOID;
+}
+
+//----------------------------------------------------------------------------
+void ResqmlPropertyToVtkDataArray::readStridedValues(const RESQML2_NS::AbstractValuesProperty *resqmlProperty)
+{
+	const unsigned int dimensionsCount = resqmlProperty->getDimensionsCountOfPatch(patchIndex);
+	if (dimensionsCount != 1 && dimensionsCount != 3)
+	{
+		vtkOutputWindowDisplayErrorText("error in : propertyValue->getDimensionsCountOfPatch (values different of 1 or 3)\n");
+		return;
 	}
-	else if (xmlTag == resqml2::DiscreteProperty::XML_TAG ||
-			 (xmlTag == resqml2::CategoricalProperty::XML_TAG &&
-			  static_cast<resqml2::CategoricalProperty const *>(valuesProperty)->getStringLookup() != nullptr))
+	if (iCellCount == 0 || jCellCount == 0)
 	{
-		int32_t* values = new int32_t[nbElement * elementCountPerValue]; // deleted by VTK data vtkSmartPointer
-		valuesProperty->getInt32ValuesOfPatch(patch_index, values);
+		return;
+	}
 
-		vtkSmartPointer<vtkIntArray> cellDataInt = vtkSmartPointer<vtkIntArray>::New();
-		cellDataInt->SetNumberOfComponents(elementCountPerValue);
-		cellDataInt->SetName(name.c_str());
-		cellDataInt->SetArray(values, nbElement * elementCountPerValue, 0, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-		this->dataArray = cellDataInt;
+	// a 3d patch is read on the I/J range of the block, a 1d patch by whole K layer
+	const uint32_t iReadCount = dimensionsCount == 3 ? (iCellCount - 1) * stride + 1 : gridICellCount;
+	const uint32_t jReadCount = dimensionsCount == 3 ? (jCellCount - 1) * stride + 1 : gridJCellCount;
+	const uint64_t layerValueCount = static_cast<uint64_t>(iReadCount) * jReadCount;
+	const uint64_t blockOffset = dimensionsCount == 3 ? 0 : static_cast<uint64_t>(initJIndex) * gridICellCount + initIIndex;
+	const uint64_t coarseLayerValueCount = static_cast<uint64_t>(iCellCount) * jCellCount;
+	const bool isFloat = this->dataArray->GetDataType() == VTK_FLOAT;
+	std::unique_ptr<float[]> layerFloatValues(isFloat ? new float[layerValueCount] : nullptr);
+	std::unique_ptr<int32_t[]> layerIntValues(isFloat ? nullptr : new int32_t[layerValueCount]);
+	for (uint32_t kCellIndex = 0; kCellIndex < kCellCount; ++kCellIndex)
+	{
+		const uint32_t kLayer = initKIndex + kCellIndex * stride;
+		const uint64_t layerOffset = static_cast<uint64_t>(gridICellCount) * gridJCellCount * kLayer;
+		if (isFloat)
+		{
+			if (dimensionsCount == 3)
+			{
+				resqmlProperty->getFloatValuesOf3dPatch(patchIndex, layerFloatValues.get(), iReadCount, jReadCount, 1, initIIndex, initJIndex, kLayer);
+			}
+			else
+			{
+				resqmlProperty->getFloatValuesOfPatch(patchIndex, layerFloatValues.get(), &layerValueCount, &layerOffset, 1);
+			}
+			copyStridedValues(layerFloatValues.get() + blockOffset, iReadCount,
+							  static_cast<vtkFloatArray *>(this->dataArray.Get())->GetPointer(0) + kCellIndex * coarseLayerValueCount,
+							  iCellCount, jCellCount, stride);
+		}
+		else
+		{
+			if (dimensionsCount == 3)
+			{
+				resqmlProperty->getIntValuesOf3dPatch(patchIndex, layerIntValues.get(), iReadCount, jReadCount, 1, initIIndex, initJIndex, kLayer);
+			}
+			else
+			{
+				resqmlProperty->getIntValuesOfPatch(patchIndex, layerIntValues.get(), &layerValueCount, &layerOffset, 1);
+			}
+			copyStridedValues(layerIntValues.get() + blockOffset, iReadCount,
+							  static_cast<vtkIntArray *>(this->dataArray.Get())->GetPointer(0) + kCellIndex * coarseLayerValueCount,
+							  iCellCount, jCellCount, stride);
+		}
+	}
+}
+
+//----------------------------------------------------------------------------
+void ResqmlPropertyToVtkDataArray::readValues(const RESQML2_NS::AbstractValuesProperty *resqmlProperty)
+{
+	if (isHyperslabed && stride > 1)
+	{
+		readStridedValues(resqmlProperty);
+	}
+	else if (isHyperslabed)
+	{
+		// a 1d patch is read by whole K layers (contiguous values), then the I/J block is extracted from them
+		const bool isWholeLayers = iCellCount == gridICellCount && jCellCount == gridJCellCount;
+		const uint64_t numValuesInEachDimension = static_cast<uint64_t>(gridICellCount) * gridJCellCount * kCellCount;
+		const uint64_t offsetInEachDimension = static_cast<uint64_t>(gridICellCount) * gridJCellCount * initKIndex;
+		const unsigned int dimensionsCount = resqmlProperty->getDimensionsCountOfPatch(patchIndex);
+		if (this->dataArray->GetDataType() == VTK_FLOAT)
+		{
+			float *valuesFloatSet = static_cast<vtkFloatArray *>(this->dataArray.Get())->GetPointer(0);
+			if (dimensionsCount == 3)
+			{
+				resqmlProperty->getFloatValuesOf3dPatch(patchIndex, valuesFloatSet, iCellCount, jCellCount, kCellCount, initIIndex, initJIndex, initKIndex);
+			}
+			else if (dimensionsCount == 1 && isWholeLayers)
+			{
+				resqmlProperty->getFloatValuesOfPatch(patchIndex, valuesFloatSet, &numValuesInEachDimension, &offsetInEachDimension, 1);
+			}
+			else if (dimensionsCount == 1)
+			{
+				std::unique_ptr<float[]> layerValues(new float[numValuesInEachDimension]);
+				resqmlProperty->getFloatValuesOfPatch(patchIndex, layerValues.get(), &numValuesInEachDimension, &offsetInEachDimension, 1);
+				copyBlockValues(layerValues.get(), valuesFloatSet, gridICellCount, gridJCellCount, iCellCount, jCellCount, kCellCount, initIIndex, initJIndex);
+			}
+			else
+			{
+				vtkOutputWindowDisplayErrorText("error in : propertyValue->getDimensionsCountOfPatch (values different of 1 or 3)\n");
+			}
+		}
+		else
+		{
+			int32_t *valuesIntSet = static_cast<vtkIntArray *>(this->dataArray.Get())->GetPointer(0);
+			if (dimensionsCount == 3)
+			{
+				resqmlProperty->getIntValuesOf3dPatch(patchIndex, valuesIntSet, iCellCount, jCellCount, kCellCount, initIIndex, initJIndex, initKIndex);
+			}
+			else if (dimensionsCount == 1 && isWholeLayers)
+			{
+				resqmlProperty->getIntValuesOfPatch(patchIndex, valuesIntSet, &numValuesInEachDimension, &offsetInEachDimension, 1);
+			}
+			else if (dimensionsCount == 1)
+			{
+				std::unique_ptr<int32_t[]> layerValues(new int32_t[numValuesInEachDimension]);
+				resqmlProperty->getIntValuesOfPatch(patchIndex, layerValues.get(), &numValuesInEachDimension, &offsetInEachDimension, 1);
+				copyBlockValues(layerValues.get(), valuesIntSet, gridICellCount, gridJCellCount, iCellCount, jCellCount, kCellCount, initIIndex, initJIndex);
+			}
+			else
+			{
+				vtkOutputWindowDisplayErrorText("error in : propertyValue->getDimensionsCountOfPatch (values different of 1 or 3)\n");
+			}
+		}
+	}
+	else if (this->dataArray->GetDataType() == VTK_DOUBLE)
+	{
+		resqmlProperty->getDoubleValuesOfPatch(patchIndex, static_cast<vtkDoubleArray *>(this->dataArray.Get())->GetPointer(0));
+	}
+	else if (this->dataArray->GetDataType() == VTK_FLOAT)
+	{
+		resqmlProperty->getFloatValuesOfPatch(patchIndex, static_cast<vtkFloatArray *>(this->dataArray.Get())->GetPointer(0));
 	}
 	else
 	{
-		throw std::invalid_argument("does not support property which are not discrete or categorical or continuous yet");
+		resqmlProperty->getInt32ValuesOfPatch(patchIndex, static_cast<vtkIntArray *>(this->dataArray.Get())->GetPointer(0));
 	}
 }
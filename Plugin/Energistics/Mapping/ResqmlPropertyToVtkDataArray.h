@@ -37,7 +37,11 @@ class ResqmlPropertyToVtkDataArray
 {
 public:
 	/**
-	 * Constructor for multi-processor
+	 * Constructor for multi-processor: the values of the I/J/K block of the process
+	 * @param iCellCount, jCellCount, kCellCount	the cell counts of the block
+	 * @param initIIndex, initJIndex, initKIndex	the first cell of the block
+	 * @param gridICellCount, gridJCellCount		the cell counts of the whole grid
+	 * @param stride	read a cell every stride cells of the grid along each axis from the first cell of the block (coarsened grid)
 	 */
 	ResqmlPropertyToVtkDataArray(const RESQML2_NS::AbstractValuesProperty *resqmlProperty,
 								 uint64_t cellCount,
@@ -45,22 +49,72 @@ public:
 								 uint32_t iCellCount,
 								 uint32_t jCellCount,
 								 uint32_t kCellCount,
+								 uint32_t initIIndex,
+								 uint32_t initJIndex,
 								 uint32_t initKIndex,
-								 uint64_t patch_index);
+								 uint32_t gridICellCount,
+								 uint32_t gridJCellCount,
+								 uint64_t patch_index,
+								 uint32_t stride = 1);
 
 	/**
 	 * Constructor
+	 * @param singlePrecision	store the continuous values as float instead of double
 	 */
 	ResqmlPropertyToVtkDataArray(RESQML2_NS::AbstractValuesProperty const *resqmlProperty,
 								 uint64_t cellCount,
 								 uint64_t pointCount,
-								 uint64_t patch_index);
+								 uint64_t patch_index,
+								 bool singlePrecision = false);
 
 	~ResqmlPropertyToVtkDataArray() = default;
 
 	vtkSmartPointer<vtkDataArray> getVtkData() { return dataArray; }
 
+	/**
+	 * Read the values of another property (e.g. another time step of a time series) into the current array:
+	 * its buffer is reused if this object is its sole owner, otherwise a new array with the same name is allocated.
+	 * @return false if the values cannot be read in place (different value type or count)
+	 */
+	bool replaceValues(const RESQML2_NS::AbstractValuesProperty *resqmlProperty);
+
 private:
+	/**
+	 * @return the VTK type of the array of resqmlProperty (VTK_VOID if the property is not supported)
+	 */
+	int getVtkDataType(const RESQML2_NS::AbstractValuesProperty *resqmlProperty) const;
+
+	/**
+	 * copy on write: replace dataArray by a new array of the same name, type and size if it is referenced elsewhere
+	 * (e.g. by an output dataset already handed to the pipeline)
+	 */
+	void detachSharedArray();
+
+	/**
+	 * read the values of resqmlProperty into dataArray (already allocated with the right type and count)
+	 */
+	void readValues(const RESQML2_NS::AbstractValuesProperty *resqmlProperty);
+
+	/**
+	 * read the values of the cells of a coarsened grid into dataArray: the first K layer of each coarse layer is read
+	 */
+	void readStridedValues(const RESQML2_NS::AbstractValuesProperty *resqmlProperty);
+
 	vtkSmartPointer<vtkDataArray> dataArray;
+
+	// reading parameters (multi-processor: hyperslab of an I/J/K block)
+	bool isHyperslabed;
+	bool singlePrecision;
+	uint64_t cellCount;
+	uint32_t iCellCount;
+	uint32_t jCellCount;
+	uint32_t kCellCount;
+	uint32_t initIIndex;
+	uint32_t initJIndex;
+	uint32_t initKIndex;
+	uint32_t gridICellCount;
+	uint32_t gridJCellCount;
+	uint32_t stride;
+	uint64_t patchIndex;
 };
 #endif
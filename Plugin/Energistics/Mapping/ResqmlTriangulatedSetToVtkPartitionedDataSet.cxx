@@ -69,6 +69,8 @@ void ResqmlTriangulatedSetToVtkPartitionedDataSet::loadVtkObject()
 	for (unsigned int patchIndex = 0; patchIndex < patchCount; ++patchIndex)
 	{
 		auto rep = new ResqmlTriangulatedToVtkPolyData(triangulatedSet, patchIndex, _procNumber, _maxProc);
+		rep->setSinglePrecision(_singlePrecision);
+		rep->loadVtkObject();
 		partition->SetPartition(patchIndex, rep->getOutput()->GetPartitionAsDataObject(0));
 		partition->GetMetaData(patchIndex)->Set(vtkCompositeDataSet::NAME(), ("Patch " + std::to_string(patchIndex)).c_str());
 		patchIndex_to_ResqmlTriangulated[patchIndex] = rep;
@@ -44,8 +44,6 @@ ResqmlTriangulatedToVtkPolyData::ResqmlTriangulatedToVtkPolyData(const RESQML2_N
 	_pointCount = triangulated->getXyzPointCountOfPatch(patch_index);
 
 	_vtkData = vtkSmartPointer<vtkPartitionedDataSet>::New();
-
-	this->loadVtkObject();
 }
 
 //----------------------------------------------------------------------------
@@ -92,8 +90,9 @@ void ResqmlTriangulatedToVtkPolyData::loadVtkObject()
 	vtkUnderlyingArray->SetNumberOfComponents(3);
 	// Take ownership of the underlying C array
 	vtkUnderlyingArray->SetArray(allXyzPoints, coordCount, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-	vtkPts->SetData(vtkUnderlyingArray);
+	vtkPts->SetData(createPointsData(vtkUnderlyingArray));
 	vtk_polydata->SetPoints(vtkPts);
+	addLocalOrigin(vtk_polydata);
 
 	// CELLS
 	const size_t previousPatchesNodeCount = getPreviousPatchesNodeCount();
@@ -89,6 +89,7 @@ void ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid::loadVtkObject()
     vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid = vtkSmartPointer<vtkUnstructuredGrid>::New();
 		vtk_unstructuredGrid->Allocate(subRep->getElementCountOfPatch(0));
 		vtk_unstructuredGrid->SetPoints(this->getMapperVtkPoint());
+		this->mapperUnstructuredGrid->addLocalOrigin(vtk_unstructuredGrid);
 
 		supportingGrid->loadGeometry();
 		// CELLS
@@ -106,58 +107,20 @@ void ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid::loadVtkObject()
 		std::unique_ptr<uint64_t[]> elementIndices(new uint64_t[cellCount]);
 		subRep->getElementIndicesOfPatch(0, 0, elementIndices.get());
 
+		// the point indices of the cells are read from fesapi while holding the fesapi lock
+		ResqmlUnstructuredGridToVtkUnstructuredGrid::CellBuffer cells;
 		for (uint64_t cellIndex = _procNumber * cellCount / _maxProc; cellIndex < maxCellIndex; ++cellIndex)
 		{
-			bool isOptimizedCell = false;
-
-			const uint64_t localFaceCount = supportingGrid->getFaceCountOfCell(elementIndices[cellIndex]);
-
-			// Following https://kitware.github.io/vtk-examples/site/VTKBook/05Chapter5/#Figure%205-2
-			if (localFaceCount == 4)
-			{ // VTK_TETRA
-				this->mapperUnstructuredGrid->cellVtkTetra(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), elementIndices[cellIndex]);
-				isOptimizedCell = true;
-			}
-			else if (localFaceCount == 5)
-			{ // VTK_WEDGE or VTK_PYRAMID
-				this->mapperUnstructuredGrid->cellVtkWedgeOrPyramid(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), elementIndices[cellIndex]);
-				isOptimizedCell = true;
-			}
-			else if (localFaceCount == 6)
-			{ // VTK_HEXAHEDRON
-				isOptimizedCell = this->mapperUnstructuredGrid->cellVtkHexahedron(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), elementIndices[cellIndex]);
-			}
-			else if (localFaceCount == 7)
-			{ // VTK_PENTAGONAL_PRISM
-				isOptimizedCell = this->mapperUnstructuredGrid->cellVtkPentagonalPrism(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), elementIndices[cellIndex]);
-			}
-			else if (localFaceCount == 8)
-			{ // VTK_HEXAGONAL_PRISM
-				isOptimizedCell = this->mapperUnstructuredGrid->cellVtkHexagonalPrism(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), elementIndices[cellIndex]);
-			}
-
-			if (!isOptimizedCell)
-			{
-        vtkSmartPointer<vtkIdList> idList = vtkSmartPointer<vtkIdList>::New();
-
-				// For polyhedron cell, a special ptIds input format is required : (numCellFaces, numFace0Pts, id1, id2, id3, numFace1Pts, id1, id2, id3, ...)
-				idList->InsertNextId(localFaceCount);
-				for (uint64_t localFaceIndex = 0; localFaceIndex < localFaceCount; ++localFaceIndex)
-				{
-					const unsigned int localNodeCount = supportingGrid->getNodeCountOfFaceOfCell(elementIndices[cellIndex], localFaceIndex);
-					idList->InsertNextId(localNodeCount);
-					uint64_t const *nodeIndices = supportingGrid->getNodeIndicesOfFaceOfCell(elementIndices[cellIndex], localFaceIndex);
-					for (unsigned int i = 0; i < localNodeCount; ++i)
-					{
-						idList->InsertNextId(nodeIndices[i]);
-					}
-				}
-
-				vtk_unstructuredGrid->InsertNextCell(VTK_POLYHEDRON, idList);
-			}
+			this->mapperUnstructuredGrid->insertCell(cells, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), elementIndices[cellIndex]);
 		}
 		supportingGrid->unloadGeometry();
 
+		{
+			// the cells are inserted in the VTK grid without holding the fesapi lock
+			FesapiUnlock fesapiUnlock;
+			cells.insertInto(vtk_unstructuredGrid);
+		}
+
 		_vtkData->SetPartition(0, vtk_unstructuredGrid);
 		_vtkData->Modified();
 	}
@@ -165,6 +128,7 @@ void ResqmlUnstructuredGridSubRepToVtkUnstructuredGrid::loadVtkObject()
 	{
 		vtkSmartPointer<vtkPolyData> vtk_polydata = vtkSmartPointer<vtkPolyData>::New();
 		vtk_polydata->SetPoints(this->getMapperVtkPoint());
+		this->mapperUnstructuredGrid->addLocalOrigin(vtk_polydata);
 
     // FACES
 		const uint64_t gridFaceCount = supportingGrid->getFaceCount();
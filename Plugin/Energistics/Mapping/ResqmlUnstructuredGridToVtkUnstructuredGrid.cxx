@@ -18,6 +18,8 @@ under the License.
 -----------------------------------------------------------------------*/
 #include "Mapping/ResqmlUnstructuredGridToVtkUnstructuredGrid.h"
 
+#include <algorithm>
+
 // VTK
 #include <vtkCellData.h>
 #include <vtkPointData.h>
@@ -69,6 +71,7 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::loadVtkObject()
 
 	// POINTS
 	vtk_unstructuredGrid->SetPoints(this->getVtkPoints());
+	addLocalOrigin(vtk_unstructuredGrid);
 
 	const_cast<RESQML2_NS::UnstructuredGridRepresentation *>(unstructuredGrid)->loadGeometry();
 
@@ -91,64 +94,107 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::loadVtkObject()
 		}
 	}
 
-	auto maxCellIndex = (_procNumber + 1) * cellCount / _maxProc;
-
+	// the point indices of the cells are read from fesapi while holding the fesapi lock
+	CellBuffer cells;
+	const uint64_t maxCellIndex = (_procNumber + 1) * cellCount / _maxProc;
 	for (uint64_t cellIndex = _procNumber * cellCount / _maxProc; cellIndex < maxCellIndex; ++cellIndex)
 	{
-		bool isOptimizedCell = false;
+		insertCell(cells, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), cellIndex);
+	}
 
-		const uint64_t localFaceCount = unstructuredGrid->getFaceCountOfCell(cellIndex);
+	const_cast<RESQML2_NS::UnstructuredGridRepresentation *>(unstructuredGrid)->unloadGeometry();
 
-		// Following https://kitware.github.io/vtk-examples/site/VTKBook/05Chapter5/#Figure%205-2
-		if (localFaceCount == 4)
-		{ // VTK_TETRA
-			cellVtkTetra(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), cellIndex);
-			isOptimizedCell = true;
-		}
-		else if (localFaceCount == 5)
-		{ // VTK_WEDGE or VTK_PYRAMID
-			cellVtkWedgeOrPyramid(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), cellIndex);
-			isOptimizedCell = true;
-		}
-		else if (localFaceCount == 6)
-		{ // VTK_HEXAHEDRON
-			isOptimizedCell = cellVtkHexahedron(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), cellIndex);
-		}
-		else if (localFaceCount == 7)
-		{ // VTK_PENTAGONAL_PRISM
-			isOptimizedCell = cellVtkPentagonalPrism(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), cellIndex);
-		}
-		else if (localFaceCount == 8)
-		{ // VTK_HEXAGONAL_PRISM
-			isOptimizedCell = cellVtkHexagonalPrism(vtk_unstructuredGrid, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected.get(), cellIndex);
-		}
+	{
+		// the cells are inserted in the VTK grid without holding the fesapi lock
+		FesapiUnlock fesapiUnlock;
+		cells.insertInto(vtk_unstructuredGrid);
+	}
 
-		if (!isOptimizedCell)
-		{
-			vtkSmartPointer<vtkIdList> idList = vtkSmartPointer<vtkIdList>::New();
+	_vtkData->SetPartition(0, vtk_unstructuredGrid);
+	_vtkData->Modified();
+}
 
-			// For polyhedron cell, a special ptIds input format is required : (numCellFaces, numFace0Pts, id1, id2, id3, numFace1Pts, id1, id2, id3, ...)
-			idList->InsertNextId(localFaceCount);
-			for (uint64_t localFaceIndex = 0; localFaceIndex < localFaceCount; ++localFaceIndex)
-			{
-				const uint64_t localNodeCount = unstructuredGrid->getNodeCountOfFaceOfCell(cellIndex, localFaceIndex);
-				idList->InsertNextId(localNodeCount);
-				uint64_t const *nodeIndices = unstructuredGrid->getNodeIndicesOfFaceOfCell(cellIndex, localFaceIndex);
-				for (size_t i = 0; i < localNodeCount; ++i)
-				{
-					idList->InsertNextId(nodeIndices[i]);
-				}
-			}
+//----------------------------------------------------------------------------
+void ResqmlUnstructuredGridToVtkUnstructuredGrid::CellBuffer::insertNextCell(unsigned char type, vtkIdType pointCount, vtkIdType const *pointIds)
+{
+	types.push_back(type);
+	connectivity.insert(connectivity.end(), pointIds, pointIds + pointCount);
+	offsets.push_back(static_cast<vtkIdType>(connectivity.size()));
+}
 
+//----------------------------------------------------------------------------
+void ResqmlUnstructuredGridToVtkUnstructuredGrid::CellBuffer::insertInto(vtkUnstructuredGrid *vtk_unstructuredGrid) const
+{
+	vtkSmartPointer<vtkIdList> idList = vtkSmartPointer<vtkIdList>::New();
+	for (size_t cellIndex = 0; cellIndex < types.size(); ++cellIndex)
+	{
+		const vtkIdType first = cellIndex == 0 ? 0 : offsets[cellIndex - 1];
+		const vtkIdType pointCount = offsets[cellIndex] - first;
+		if (types[cellIndex] == VTK_POLYHEDRON)
+		{
+			// For polyhedron cell, a special ptIds input format is required : (numCellFaces, numFace0Pts, id1, id2, id3, numFace1Pts, id1, id2, id3, ...)
+			idList->SetNumberOfIds(pointCount);
+			std::copy(connectivity.data() + first, connectivity.data() + first + pointCount, idList->GetPointer(0));
 			vtk_unstructuredGrid->InsertNextCell(VTK_POLYHEDRON, idList);
 		}
+		else
+		{
+			vtk_unstructuredGrid->InsertNextCell(types[cellIndex], pointCount, connectivity.data() + first);
+		}
 	}
+}
 
-	const_cast<RESQML2_NS::UnstructuredGridRepresentation *>(unstructuredGrid)->unloadGeometry();
+//----------------------------------------------------------------------------
+void ResqmlUnstructuredGridToVtkUnstructuredGrid::insertCell(CellBuffer &cells,
+															 uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected,
+															 uint64_t cellIndex)
+{
+	RESQML2_NS::UnstructuredGridRepresentation const *unstructuredGrid = getResqmlData();
 
-	_vtkData->SetPartition(0, vtk_unstructuredGrid);
-	_vtkData->Modified();
+	bool isOptimizedCell = false;
+
+	const uint64_t localFaceCount = unstructuredGrid->getFaceCountOfCell(cellIndex);
+
+	// Following https://kitware.github.io/vtk-examples/site/VTKBook/05Chapter5/#Figure%205-2
+	if (localFaceCount == 4)
+	{ // VTK_TETRA
+		cellVtkTetra(cells, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected, cellIndex);
+		isOptimizedCell = true;
+	}
+	else if (localFaceCount == 5)
+	{ // VTK_WEDGE or VTK_PYRAMID
+		cellVtkWedgeOrPyramid(cells, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected, cellIndex);
+		isOptimizedCell = true;
+	}
+	else if (localFaceCount == 6)
+	{ // VTK_HEXAHEDRON
+		isOptimizedCell = cellVtkHexahedron(cells, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected, cellIndex);
+	}
+	else if (localFaceCount == 7)
+	{ // VTK_PENTAGONAL_PRISM
+		isOptimizedCell = cellVtkPentagonalPrism(cells, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected, cellIndex);
+	}
+	else if (localFaceCount == 8)
+	{ // VTK_HEXAGONAL_PRISM
+		isOptimizedCell = cellVtkHexagonalPrism(cells, cumulativeFaceCountPerCell, cellFaceNormalOutwardlyDirected, cellIndex);
+	}
+
+	if (!isOptimizedCell)
+	{
+		// For polyhedron cell, a special ptIds input format is required : (numCellFaces, numFace0Pts, id1, id2, id3, numFace1Pts, id1, id2, id3, ...)
+		std::vector<vtkIdType> faceStream;
+		faceStream.push_back(localFaceCount);
+		for (uint64_t localFaceIndex = 0; localFaceIndex < localFaceCount; ++localFaceIndex)
+		{
+			const uint64_t localNodeCount = unstructuredGrid->getNodeCountOfFaceOfCell(cellIndex, localFaceIndex);
+			faceStream.push_back(localNodeCount);
+			uint64_t const *nodeIndices = unstructuredGrid->getNodeIndicesOfFaceOfCell(cellIndex, localFaceIndex);
+			faceStream.insert(faceStream.end(), nodeIndices, nodeIndices + localNodeCount);
+		}
+		cells.insertNextCell(VTK_POLYHEDRON, static_cast<vtkIdType>(faceStream.size()), faceStream.data());
+	}
 }
+
 //----------------------------------------------------------------------------
 vtkSmartPointer<vtkPoints> ResqmlUnstructuredGridToVtkUnstructuredGrid::getVtkPoints()
 {
@@ -162,6 +208,7 @@ vtkSmartPointer<vtkPoints> ResqmlUnstructuredGridToVtkUnstructuredGrid::getVtkPo
 //----------------------------------------------------------------------------
 void ResqmlUnstructuredGridToVtkUnstructuredGrid::createPoints()
 {
+	ScopedTimer timer(_loadingStatistics.pointsTime);
 	const RESQML2_NS::UnstructuredGridRepresentation *unstructuredGrid = getResqmlData();
 
 	// POINTS
@@ -187,6 +234,7 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::createPoints()
 	}
 
 	const uint64_t coordCount =_pointCount * 3;
+	recordReading(coordCount, sizeof(double));
 	if (!partialCRS && unstructuredGrid->getLocalCrs(0)->isDepthOriented())
 	{
 		for (uint_fast64_t zCoordIndex = 2; zCoordIndex < coordCount; zCoordIndex += 3)
@@ -198,11 +246,11 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::createPoints()
 	vtkUnderlyingArray->SetNumberOfComponents(3);
 	// Take ownership of the underlying C array
 	vtkUnderlyingArray->SetArray(allXyzPoints, coordCount, vtkAbstractArray::VTK_DATA_ARRAY_DELETE);
-	this->points->SetData(vtkUnderlyingArray);
+	this->points->SetData(createPointsData(vtkUnderlyingArray));
 }
 
 //----------------------------------------------------------------------------
-void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkTetra(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
+void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkTetra(CellBuffer &cells,
 															   uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected,
 															   uint64_t cellIndex)
 {
@@ -238,11 +286,11 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkTetra(vtkSmartPointer<v
 		}
 	}
 
-	vtk_unstructuredGrid->InsertNextCell(VTK_TETRA, 4, nodes.data());
+	cells.insertNextCell(VTK_TETRA, 4, nodes.data());
 }
 
 //----------------------------------------------------------------------------
-void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkWedgeOrPyramid(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
+void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkWedgeOrPyramid(CellBuffer &cells,
 																		uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected,
 																		uint64_t cellIndex)
 {
@@ -377,7 +425,7 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkWedgeOrPyramid(vtkSmart
 			}
 		}
 
-		vtk_unstructuredGrid->InsertNextCell(VTK_WEDGE, 6, nodes.data());
+		cells.insertNextCell(VTK_WEDGE, 6, nodes.data());
 	}
 	else if (localFaceIndexWith4Nodes.size() == 1)
 	{ // VTK_PYRAMID
@@ -413,7 +461,7 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkWedgeOrPyramid(vtkSmart
 			}
 		}
 
-		vtk_unstructuredGrid->InsertNextCell(VTK_PYRAMID, 5, nodes.data());
+		cells.insertNextCell(VTK_PYRAMID, 5, nodes.data());
 	}
 	else
 	{
@@ -422,7 +470,7 @@ void ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkWedgeOrPyramid(vtkSmart
 }
 
 //----------------------------------------------------------------------------
-bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkHexahedron(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
+bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkHexahedron(CellBuffer &cells,
 																	uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected,
 																	uint64_t cellIndex)
 {
@@ -480,12 +528,12 @@ bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkHexahedron(vtkSmartPoin
 		}
 	}
 
-	vtk_unstructuredGrid->InsertNextCell(VTK_HEXAHEDRON, 8, nodes.data());
+	cells.insertNextCell(VTK_HEXAHEDRON, 8, nodes.data());
 	return true;
 }
 
 //----------------------------------------------------------------------------
-bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkPentagonalPrism(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
+bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkPentagonalPrism(CellBuffer &cells,
 																		 uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected, uint64_t cellIndex)
 {
 	RESQML2_NS::UnstructuredGridRepresentation const *unstructuredGrid = getResqmlData();
@@ -551,14 +599,14 @@ bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkPentagonalPrism(vtkSmar
 
 	if (faceWith5Nodes == 2 && faceWith4Nodes == 5)
 	{
-		vtk_unstructuredGrid->InsertNextCell(VTK_PENTAGONAL_PRISM, 10, nodes.data());
+		cells.insertNextCell(VTK_PENTAGONAL_PRISM, 10, nodes.data());
 		return true;
 	}
 	return false;
 }
 
 //----------------------------------------------------------------------------
-bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkHexagonalPrism(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
+bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkHexagonalPrism(CellBuffer &cells,
 																		uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected, uint64_t cellIndex)
 {
 	const RESQML2_NS::UnstructuredGridRepresentation *unstructuredGrid = getResqmlData();
@@ -624,7 +672,7 @@ bool ResqmlUnstructuredGridToVtkUnstructuredGrid::cellVtkHexagonalPrism(vtkSmart
 
 	if (faceWith6Nodes == 2 && faceWith4Nodes == 6)
 	{
-		vtk_unstructuredGrid->InsertNextCell(VTK_HEXAGONAL_PRISM, 12, nodes.data());
+		cells.insertNextCell(VTK_HEXAGONAL_PRISM, 12, nodes.data());
 		return true;
 	}
 	return false;
@@ -20,6 +20,7 @@ under the License.
 #define __ResqmlUnstructuredGridToVtkUnstructuredGrid_h
 
 #include <array>
+#include <vector>
 
 #include "ResqmlAbstractRepresentationToVtkPartitionedDataSet.h"
 
@@ -52,6 +53,20 @@ public:
 	void createPoints();
 
 protected:
+	/**
+	 * Cells computed from the fesapi geometry while holding the fesapi lock, then inserted in a VTK grid without it.
+	 * A VTK_POLYHEDRON cell is stored as its face stream.
+	 */
+	struct CellBuffer
+	{
+		std::vector<unsigned char> types;
+		std::vector<vtkIdType> offsets; // end of each cell in connectivity
+		std::vector<vtkIdType> connectivity;
+
+		void insertNextCell(unsigned char type, vtkIdType pointCount, vtkIdType const *pointIds);
+		void insertInto(vtkUnstructuredGrid *vtk_unstructuredGrid) const;
+	};
+
 	const RESQML2_NS::UnstructuredGridRepresentation *getResqmlData() const;
 	vtkSmartPointer<vtkPoints> points;
 	// Index of the nodes constituting a single VTK optimized cell
@@ -64,15 +79,28 @@ private:
 	 */
 	vtkSmartPointer<vtkPoints> getVtkPoints();
 
+	/**
+	 * Add the VTK cell (optimized or polyhedron) corresponding to a particular RESQML cell
+	 *
+	 * @param cells								The cells to insert in the VTK UnstructuredGrid
+	 * @param cumulativeFaceCountPerCell		The cumulative count of faces for each cell of the RESQML UnstructuredGridRepresentation.
+	 * @param cellFaceNormalOutwardlyDirected	Indicates for each cell face of the RESQML UnstructuredGridRepresentation if its normal using the right hand rule is outwardly directed.
+	 * @param cellIndex							The index of the RESQML cell in the RESQML UnstructuredGridRepresentation to be mapped.
+	 */
+	void insertCell(CellBuffer &cells,
+					uint64_t const *cumulativeFaceCountPerCell,
+					unsigned char const *cellFaceNormalOutwardlyDirected,
+					uint64_t cellIndex);
+
 	/**
 	 * Insert a new VTK tetrahedron corresponding to a particular RESQML cell
 	 *
-	 * @param unstructuredGridRep				The RESQML UnstructuredGridRepresentation which contains the cell to map and to insert in the VTK UnstructuredGrid
+	 * @param cells								The cells to insert in the VTK UnstructuredGrid
 	 * @param cumulativeFaceCountPerCell			The cumulative count of faces for each cell of the RESQML UnstructuredGridRepresentation.
 	 * @param cellFaceNormalOutwardlyDirected	Indicates for each cell face of the RESQML UnstructuredGridRepresentation if its normal using the right hand rule is outwardly directed.
 	 * @param cellIndex							The index of the RESQML cell in the RESQML UnstructuredGridRepresentation to be mapped and inserted in the VTK UnstructuredGrid.
 	 */
-	void cellVtkTetra(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
+	void cellVtkTetra(CellBuffer &cells,
 					  uint64_t const *cumulativeFaceCountPerCell,
 					  unsigned char const *cellFaceNormalOutwardlyDirected,
 					  uint64_t cellIndex);
@@ -80,26 +108,26 @@ private:
 	/**
 	 * Insert a new VTK wedge or pyramid corresponding to a particular RESQML cell
 	 *
-	 * @param unstructuredGridRep				The RESQML UnstructuredGridRepresentation which contains the cell to map and to insert in the VTK UnstructuredGrid
+	 * @param cells								The cells to insert in the VTK UnstructuredGrid
 	 * @param cumulativeFaceCountPerCell		The cumulative count of faces for each cell of the RESQML UnstructuredGridRepresentation.
 	 * @param cellFaceNormalOutwardlyDirected	Indicates for each cell face of the RESQML UnstructuredGridRepresentation if its normal using the right hand rule is outwardly directed.
 	 * @param cellIndex							The index of the RESQML cell in the RESQML UnstructuredGridRepresentation to be mapped and inserted in the VTK UnstructuredGrid.
 	 */
-	void cellVtkWedgeOrPyramid(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
+	void cellVtkWedgeOrPyramid(CellBuffer &cells,
 							   uint64_t const *cumulativeFaceCountPerCell, unsigned char const *cellFaceNormalOutwardlyDirected,
 							   uint64_t cellIndex);
 
 	/**
 	 * Insert a new VTK hexahedron corresponding to a particular RESQML cell only if the RESQML cell is Quadrilaterally-faced hexahedron.
 	 *
-	 * @param unstructuredGridRep				The RESQML UnstructuredGridRepresentation which contains the cell to map and to insert in the VTK UnstructuredGrid
+	 * @param cells								The cells to insert in the VTK UnstructuredGrid
 	 * @param cumulativeFaceCountPerCell		The cumulative count of faces for each cell of the RESQML UnstructuredGridRepresentation.
 	 * @param cellFaceNormalOutwardlyDirected	Indicates for each cell face of the RESQML UnstructuredGridRepresentation if its normal using the right hand rule is outwardly directed.
 	 * @param cellIndex							The index of the RESQML cell in the RESQML UnstructuredGridRepresentation to be mapped and inserted in the VTK UnstructuredGrid.
 	 *
 	 * @return true if the hexahedron is a Quadrilaterally-faced one, false otherwise
 	 */
-	bool cellVtkHexahedron(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
+	bool cellVtkHexahedron(CellBuffer &cells,
 						   uint64_t const *cumulativeFaceCountPerCell,
 						   unsigned char const *cellFaceNormalOutwardlyDirected,
 						   uint64_t cellIndex);
@@ -107,14 +135,14 @@ private:
 	/**
 	 * Insert a new VTK_PENTAGONAL_PRISM corresponding to a particular RESQML cell only if the RESQML cell contains two faces with 5 nodes.
 	 *
-	 * @param unstructuredGridRep				The RESQML UnstructuredGridRepresentation which contains the cell to map and to insert in the VTK UnstructuredGrid
+	 * @param cells								The cells to insert in the VTK UnstructuredGrid
 	 * @param cumulativeFaceCountPerCell		The cumulative count of faces for each cell of the RESQML UnstructuredGridRepresentation.
 	 * @param cellFaceNormalOutwardlyDirected	Indicates for each cell face of the RESQML UnstructuredGridRepresentation if its normal using the right hand rule is outwardly directed.
 	 * @param cellIndex							The index of the RESQML cell in the RESQML UnstructuredGridRepresentation to be mapped and inserted in the VTK UnstructuredGrid.
 	 *
 	 * @return true if the RESQML cell contains two faces with 5 nodes, false otherwise
 	 */
-	bool cellVtkPentagonalPrism(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
+	bool cellVtkPentagonalPrism(CellBuffer &cells,
 								uint64_t const *cumulativeFaceCountPerCell,
 								unsigned char const *cellFaceNormalOutwardlyDirected,
 								uint64_t cellIndex);
@@ -122,14 +150,14 @@ private:
 	/**
 	 * Insert a new VTK_HEXAGONAL_PRISM corresponding to a particular RESQML cell only if the RESQML cell contains two faces with 5 nodes.
 	 *
-	 * @param unstructuredGridRep				The RESQML UnstructuredGridRepresentation which contains the cell to map and to insert in the VTK UnstructuredGrid
+	 * @param cells								The cells to insert in the VTK UnstructuredGrid
 	 * @param cumulativeFaceCountPerCell		The cumulative count of faces for each cell of the RESQML UnstructuredGridRepresentation.
 	 * @param cellFaceNormalOutwardlyDirected	Indicates for each cell face of the RESQML UnstructuredGridRepresentation if its normal using the right hand rule is outwardly directed.
 	 * @param cellIndex							The index of the RESQML cell in the RESQML UnstructuredGridRepresentation to be mapped and inserted in the VTK UnstructuredGrid.
 	 *
 	 * @return true if the RESQML cell contains two faces with 5 nodes, false otherwise
 	 */
-	bool cellVtkHexagonalPrism(vtkSmartPointer<vtkUnstructuredGrid> vtk_unstructuredGrid,
+	bool cellVtkHexagonalPrism(CellBuffer &cells,
 							   uint64_t const *cumulativeFaceCountPerCell,
 							   unsigned char const *cellFaceNormalOutwardlyDirected,
 							   uint64_t cellIndex);
@@ -0,0 +1,688 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+
+/*
+Headless benchmark of the loading of EPC documents (no ParaView client):
+    fesppBenchmark [options] file.epc [file.epc ...]
+
+Each run builds a new repository, adds the files ("open") then loads the selected nodes ("load").
+The warmup runs are not measured. The result is written as a JSON object on the standard output.
+
+Scenarios (--scenario):
+    load      (default) time to open the files and to load the selected nodes;
+    open      time to build the tree and resident memory once it is built, e.g. with --lazy on a package
+              made by "fesppGenerateEpc --wellbores 9100" which holds about 100k data objects;
+    add       the files are added one after the other to the same repository: the time of each
+              addition should follow the number of nodes it brings, not the size of the tree;
+    play      frames per second when all the time steps are played in order, e.g. with a 100 step pressure
+              ("fesppGenerateEpc --ijk 250 200 200 --time-steps 100") selected through --select and
+              the next steps read in the background with --prefetch;
+    toggle    update latency and resident memory while a node (e.g. a property) is alternately
+              shown and hidden on top of the selected nodes, the output being handed to a
+              pipeline-like consumer as vtkEPCReader does.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// VTK includes
+#include <vtkDataAssembly.h>
+#include <vtkDataSet.h>
+#include <vtkPartitionedDataSet.h>
+#include <vtkPartitionedDataSetCollection.h>
+#include <vtkSmartPointer.h>
+
+#include "Mapping/ResqmlDataRepositoryToVtkPartitionedDataSetCollection.h"
+
+namespace
+{
+	struct BenchmarkOptions
+	{
+		std::vector<std::string> _files;
+		// data assembly paths of the selected nodes (all nodes if empty)
+		std::vector<std::string> _selectors;
+		uint32_t _repetitions = 5;
+		uint32_t _warmup = 1;
+		uint32_t _numberOfThreads = 1;
+		uint32_t _stride = 1;
+		uint32_t _prefetchedTimeSteps = 0;
+		uint32_t _frameMs = 0;
+		bool _surfaceOnly = false;
+		bool _singlePrecision = false;
+		bool _lazyLoading = false;
+		// time step to load (the first one if not set)
+		bool _hasTime = false;
+		double _time = 0.0;
+		std::string _scenario = "load";
+		// data assembly path of the node shown and hidden by the toggle scenario
+		std::string _toggle;
+	};
+
+	struct RunTimes
+	{
+		double _open;
+		double _load;
+		vtkIdType _cellCount;
+		vtkIdType _pointCount;
+		std::vector<std::pair<std::string, double>> _filePhaseTimes;
+		std::vector<std::pair<std::string, double>> _updatePhaseTimes;
+	};
+
+	// samples of each phase, in the order the phases first appear
+	typedef std::vector<std::pair<std::string, std::vector<double>>> PhaseSamples;
+
+	void printUsage()
+	{
+		std::cerr << "Usage: fesppBenchmark [options] file.epc [file.epc ...]\n"
+				  << "  --scenario NAME      load (default), open, add, play or toggle\n"
+				  << "  --repetitions N      measured runs (default 5)\n"
+				  << "  --warmup N           runs done before the measured ones (default 1)\n"
+				  << "  --threads N          threads loading the representations (0 means one per core, default 1)\n"
+				  << "  --select PATH        data assembly path of a node to load, e.g. /data/Grids (repeatable, default all)\n"
+				  << "  --time T             time step to load (default the first one)\n"
+				  << "  --stride N           coarsened preview of the IJK grids (default 1)\n"
+				  << "  --surface-only       load only the boundary faces of the IJK grids\n"
+				  << "  --single-precision   store the geometry and the continuous properties as float\n"
+				  << "  --lazy               deserialize the data objects on demand\n"
+				  << "  --prefetch N         time steps read in the background after each one (default 0)\n"
+				  << "  --frame-ms N         rendering time simulated after each time step of the play scenario (default 0)\n"
+				  << "  --toggle PATH        node shown then hidden at each repetition of the toggle scenario\n";
+	}
+
+	bool parseUnsigned(const char *p_value, uint32_t &p_result)
+	{
+		char *w_end = nullptr;
+		const unsigned long w_value = std::strtoul(p_value, &w_end, 10);
+		if (w_end == p_value || *w_end != '\0')
+		{
+			return false;
+		}
+		p_result = static_cast<uint32_t>(w_value);
+		return true;
+	}
+
+	bool parseArguments(int p_argc, char *p_argv[], BenchmarkOptions &p_options)
+	{
+		for (int w_index = 1; w_index < p_argc; ++w_index)
+		{
+			const std::string w_argument = p_argv[w_index];
+			const bool w_hasValue = w_index + 1 < p_argc;
+			if (w_argument == "--repetitions" && w_hasValue)
+			{
+				if (!parseUnsigned(p_argv[++w_index], p_options._repetitions) || p_options._repetitions == 0)
+				{
+					return false;
+				}
+			}
+			else if (w_argument == "--warmup" && w_hasValue)
+			{
+				if (!parseUnsigned(p_argv[++w_index], p_options._warmup))
+				{
+					return false;
+				}
+			}
+			else if (w_argument == "--threads" && w_hasValue)
+			{
+				if (!parseUnsigned(p_argv[++w_index], p_options._numberOfThreads))
+				{
+					return false;
+				}
+			}
+			else if (w_argument == "--stride" && w_hasValue)
+			{
+				if (!parseUnsigned(p_argv[++w_index], p_options._stride) || p_options._stride == 0)
+				{
+					return false;
+				}
+			}
+			else if (w_argument == "--scenario" && w_hasValue)
+			{
+				p_options._scenario = p_argv[++w_index];
+				if (p_options._scenario != "load" && p_options._scenario != "open" && p_options._scenario != "add" && p_options._scenario != "play" && p_options._scenario != "toggle")
+				{
+					return false;
+				}
+			}
+			else if (w_argument == "--toggle" && w_hasValue)
+			{
+				p_options._toggle = p_argv[++w_index];
+			}
+			else if (w_argument == "--prefetch" && w_hasValue)
+			{
+				if (!parseUnsigned(p_argv[++w_index], p_options._prefetchedTimeSteps))
+				{
+					return false;
+				}
+			}
+			else if (w_argument == "--frame-ms" && w_hasValue)
+			{
+				if (!parseUnsigned(p_argv[++w_index], p_options._frameMs))
+				{
+					return false;
+				}
+			}
+			else if (w_argument == "--select" && w_hasValue)
+			{
+				p_options._selectors.push_back(p_argv[++w_index]);
+			}
+			else if (w_argument == "--time" && w_hasValue)
+			{
+				p_options._hasTime = true;
+				p_options._time = std::atof(p_argv[++w_index]);
+			}
+			else if (w_argument == "--surface-only")
+			{
+				p_options._surfaceOnly = true;
+			}
+			else if (w_argument == "--single-precision")
+			{
+				p_options._singlePrecision = true;
+			}
+			else if (w_argument == "--lazy")
+			{
+				p_options._lazyLoading = true;
+			}
+			else if (w_argument.compare(0, 2, "--") == 0)
+			{
+				return false;
+			}
+			else
+			{
+				p_options._files.push_back(w_argument);
+			}
+		}
+		return !p_options._files.empty() && (p_options._scenario != "toggle" || !p_options._toggle.empty());
+	}
+
+	double elapsedMs(std::chrono::steady_clock::time_point p_start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - p_start).count();
+	}
+
+	/**
+	 * resident and peak resident memory of the process in MB (-1 if unknown on this platform)
+	 */
+	void readMemoryUsage(double &p_residentMB, double &p_peakMB)
+	{
+		p_residentMB = -1;
+		p_peakMB = -1;
+#ifdef __linux__
+		std::ifstream w_status("/proc/self/status");
+		std::string w_line;
+		while (std::getline(w_status, w_line))
+		{
+			if (w_line.compare(0, 6, "VmRSS:") == 0)
+			{
+				p_residentMB = std::atof(w_line.c_str() + 6) / 1024;
+			}
+			else if (w_line.compare(0, 6, "VmHWM:") == 0)
+			{
+				p_peakMB = std::atof(w_line.c_str() + 6) / 1024;
+			}
+		}
+#endif
+	}
+
+	/**
+	 * reset the peak resident memory to the current one (Linux only)
+	 */
+	void resetPeakMemoryUsage()
+	{
+#ifdef __linux__
+		std::ofstream w_clearRefs("/proc/self/clear_refs");
+		w_clearRefs << "5";
+#endif
+	}
+
+	std::unique_ptr<ResqmlDataRepositoryToVtkPartitionedDataSetCollection> createRepository(const BenchmarkOptions &p_options)
+	{
+		std::unique_ptr<ResqmlDataRepositoryToVtkPartitionedDataSetCollection> w_repository(new ResqmlDataRepositoryToVtkPartitionedDataSetCollection());
+		w_repository->setLazyLoading(p_options._lazyLoading);
+		w_repository->setNumberOfThreads(p_options._numberOfThreads);
+		w_repository->setNumberOfPrefetchedTimeSteps(p_options._prefetchedTimeSteps);
+		w_repository->setSinglePrecision(p_options._singlePrecision);
+		w_repository->setStride(p_options._stride);
+		w_repository->setSurfaceOnly(p_options._surfaceOnly);
+		return w_repository;
+	}
+
+	int findNode(ResqmlDataRepositoryToVtkPartitionedDataSetCollection *p_repository, const std::string &p_path)
+	{
+		const int w_nodeId = p_repository->GetAssembly()->GetFirstNodeByPath(p_path.c_str());
+		if (w_nodeId == -1)
+		{
+			throw std::invalid_argument("The node " + p_path + " is not in the tree.");
+		}
+		return w_nodeId;
+	}
+
+	void selectNodes(ResqmlDataRepositoryToVtkPartitionedDataSetCollection *p_repository, const BenchmarkOptions &p_options)
+	{
+		if (p_options._selectors.empty())
+		{
+			p_repository->selectNodeId(0);
+		}
+		for (const std::string &w_selector : p_options._selectors)
+		{
+			p_repository->selectNodeId(findNode(p_repository, w_selector));
+		}
+	}
+
+	double selectedTime(ResqmlDataRepositoryToVtkPartitionedDataSetCollection *p_repository, const BenchmarkOptions &p_options)
+	{
+		const std::vector<double> w_timeSteps = p_repository->getTimes();
+		return p_options._hasTime || w_timeSteps.empty() ? p_options._time : w_timeSteps.front();
+	}
+
+	/**
+	 * open the files and load the selected nodes with a new repository
+	 */
+	RunTimes run(const BenchmarkOptions &p_options)
+	{
+		std::unique_ptr<ResqmlDataRepositoryToVtkPartitionedDataSetCollection> w_repository = createRepository(p_options);
+
+		RunTimes w_times;
+		auto w_start = std::chrono::steady_clock::now();
+		w_repository->addFiles(p_options._files);
+		w_times._open = elapsedMs(w_start);
+
+		selectNodes(w_repository.get(), p_options);
+
+		const double w_time = selectedTime(w_repository.get(), p_options);
+		w_start = std::chrono::steady_clock::now();
+		vtkPartitionedDataSetCollection *w_output = w_repository->getVtkPartitionedDatasSetCollection(w_time);
+		w_times._load = elapsedMs(w_start);
+
+		w_times._cellCount = 0;
+		w_times._pointCount = 0;
+		for (unsigned int w_index = 0; w_index < w_output->GetNumberOfPartitionedDataSets(); ++w_index)
+		{
+			vtkPartitionedDataSet *w_partitionedDataSet = w_output->GetPartitionedDataSet(w_index);
+			if (w_partitionedDataSet == nullptr)
+			{
+				continue;
+			}
+			for (unsigned int w_partitionIndex = 0; w_partitionIndex < w_partitionedDataSet->GetNumberOfPartitions(); ++w_partitionIndex)
+			{
+				vtkDataSet *w_dataSet = w_partitionedDataSet->GetPartition(w_partitionIndex);
+				if (w_dataSet != nullptr)
+				{
+					w_times._cellCount += w_dataSet->GetNumberOfCells();
+					w_times._pointCount += w_dataSet->GetNumberOfPoints();
+				}
+			}
+		}
+		w_times._filePhaseTimes = w_repository->getFilePhaseTimes();
+		w_times._updatePhaseTimes = w_repository->getUpdatePhaseTimes();
+		return w_times;
+	}
+
+	/**
+	 * write the min, median and all samples of a duration
+	 */
+	void writeSamples(std::ostringstream &p_json, const std::string &p_name, const std::vector<double> &p_samples)
+	{
+		std::vector<double> w_sorted = p_samples;
+		std::sort(w_sorted.begin(), w_sorted.end());
+		const size_t w_middle = w_sorted.size() / 2;
+		const double w_median = w_sorted.size() % 2 == 1 ? w_sorted[w_middle] : (w_sorted[w_middle - 1] + w_sorted[w_middle]) / 2;
+
+		p_json << '"' << p_name << "\": {\"min\": " << w_sorted.front() << ", \"median\": " << w_median << ", \"samples\": [";
+		for (size_t w_index = 0; w_index < p_samples.size(); ++w_index)
+		{
+			p_json << (w_index == 0 ? "" : ", ") << p_samples[w_index];
+		}
+		p_json << "]}";
+	}
+
+	/**
+	 * add the phase times of a run to the samples (a phase repeated in the run is counted once with its total time)
+	 */
+	void addPhaseSamples(PhaseSamples &p_samples, const std::vector<std::pair<std::string, double>> &p_phaseTimes)
+	{
+		std::vector<bool> w_added(p_samples.size(), false);
+		for (const auto &w_phaseTime : p_phaseTimes)
+		{
+			auto w_phase = std::find_if(p_samples.begin(), p_samples.end(), [&w_phaseTime](const std::pair<std::string, std::vector<double>> &p_phase) -> bool
+										{ return p_phase.first == w_phaseTime.first; });
+			if (w_phase == p_samples.end())
+			{
+				p_samples.emplace_back(w_phaseTime.first, std::vector<double>());
+				w_added.push_back(false);
+				w_phase = p_samples.end() - 1;
+			}
+			const size_t w_phaseIndex = static_cast<size_t>(w_phase - p_samples.begin());
+			if (w_added[w_phaseIndex])
+			{
+				w_phase->second.back() += w_phaseTime.second;
+			}
+			else
+			{
+				w_phase->second.push_back(w_phaseTime.second);
+				w_added[w_phaseIndex] = true;
+			}
+		}
+	}
+
+	void writePhaseSamples(std::ostringstream &p_json, const PhaseSamples &p_samples)
+	{
+		p_json << '{';
+		for (size_t w_index = 0; w_index < p_samples.size(); ++w_index)
+		{
+			p_json << (w_index == 0 ? "" : ", ");
+			writeSamples(p_json, p_samples[w_index].first, p_samples[w_index].second);
+		}
+		p_json << '}';
+	}
+
+	std::string escapeJson(const std::string &p_value)
+	{
+		std::string w_result;
+		for (const char w_char : p_value)
+		{
+			if (w_char == '"' || w_char == '\\')
+			{
+				w_result += '\\';
+			}
+			w_result += w_char;
+		}
+		return w_result;
+	}
+
+	/**
+	 * load scenario: the open and load times of every run
+	 */
+	void runLoad(const BenchmarkOptions &p_options, std::ostringstream &p_json)
+	{
+		std::vector<double> w_openTimes;
+		std::vector<double> w_loadTimes;
+		PhaseSamples w_filePhases;
+		PhaseSamples w_updatePhases;
+		RunTimes w_lastRun;
+		for (uint32_t w_index = 0; w_index < p_options._warmup + p_options._repetitions; ++w_index)
+		{
+			w_lastRun = run(p_options);
+			if (w_index >= p_options._warmup)
+			{
+				w_openTimes.push_back(w_lastRun._open);
+				w_loadTimes.push_back(w_lastRun._load);
+				addPhaseSamples(w_filePhases, w_lastRun._filePhaseTimes);
+				addPhaseSamples(w_updatePhases, w_lastRun._updatePhaseTimes);
+			}
+		}
+
+		p_json << ", \"cells\": " << w_lastRun._cellCount
+			   << ", \"points\": " << w_lastRun._pointCount << ", ";
+		writeSamples(p_json, "open", w_openTimes);
+		p_json << ", ";
+		writeSamples(p_json, "load", w_loadTimes);
+		// min and median of each phase over the measured runs
+		p_json << ", \"phases\": {\"files\": ";
+		writePhaseSamples(p_json, w_filePhases);
+		p_json << ", \"update\": ";
+		writePhaseSamples(p_json, w_updatePhases);
+		p_json << '}';
+	}
+
+	/**
+	 * open scenario: each run builds the tree of the files with a new repository, nothing is loaded
+	 */
+	void runOpen(const BenchmarkOptions &p_options, std::ostringstream &p_json)
+	{
+		std::vector<double> w_openTimes;
+		std::vector<double> w_residentMB;
+		std::vector<double> w_peakMB;
+		size_t w_nodeCount = 0;
+		for (uint32_t w_index = 0; w_index < p_options._warmup + p_options._repetitions; ++w_index)
+		{
+			resetPeakMemoryUsage();
+			std::unique_ptr<ResqmlDataRepositoryToVtkPartitionedDataSetCollection> w_repository = createRepository(p_options);
+			const auto w_start = std::chrono::steady_clock::now();
+			w_repository->addFiles(p_options._files);
+			const double w_openTime = elapsedMs(w_start);
+			double w_resident;
+			double w_peak;
+			readMemoryUsage(w_resident, w_peak);
+			w_nodeCount = w_repository->GetAssembly()->GetChildNodes(0, true).size();
+			if (w_index >= p_options._warmup)
+			{
+				w_openTimes.push_back(w_openTime);
+				w_residentMB.push_back(w_resident);
+				w_peakMB.push_back(w_peak);
+			}
+		}
+
+		p_json << ", \"nodes\": " << w_nodeCount << ", ";
+		writeSamples(p_json, "open", w_openTimes);
+		p_json << ", ";
+		writeSamples(p_json, "residentMB", w_residentMB);
+		p_json << ", ";
+		writeSamples(p_json, "peakResidentMB", w_peakMB);
+	}
+
+	/**
+	 * add scenario: each run adds the files one by one to a new repository
+	 */
+	void runAdd(const BenchmarkOptions &p_options, std::ostringstream &p_json)
+	{
+		std::vector<std::vector<double>> w_addTimes(p_options._files.size());
+		std::vector<size_t> w_addedNodeCounts(p_options._files.size(), 0);
+		for (uint32_t w_index = 0; w_index < p_options._warmup + p_options._repetitions; ++w_index)
+		{
+			std::unique_ptr<ResqmlDataRepositoryToVtkPartitionedDataSetCollection> w_repository = createRepository(p_options);
+			size_t w_nodeCount = 0;
+			for (size_t w_fileIndex = 0; w_fileIndex < p_options._files.size(); ++w_fileIndex)
+			{
+				const auto w_start = std::chrono::steady_clock::now();
+				w_repository->addFiles(std::vector<std::string>(1, p_options._files[w_fileIndex]));
+				const double w_addTime = elapsedMs(w_start);
+				const size_t w_newNodeCount = w_repository->GetAssembly()->GetChildNodes(0, true).size();
+				w_addedNodeCounts[w_fileIndex] = w_newNodeCount - w_nodeCount;
+				w_nodeCount = w_newNodeCount;
+				if (w_index >= p_options._warmup)
+				{
+					w_addTimes[w_fileIndex].push_back(w_addTime);
+				}
+			}
+		}
+
+		p_json << ", \"additions\": [";
+		for (size_t w_fileIndex = 0; w_fileIndex < p_options._files.size(); ++w_fileIndex)
+		{
+			p_json << (w_fileIndex == 0 ? "" : ", ") << "{\"addedNodes\": " << w_addedNodeCounts[w_fileIndex] << ", ";
+			writeSamples(p_json, "add", w_addTimes[w_fileIndex]);
+			p_json << '}';
+		}
+		p_json << ']';
+	}
+
+	/**
+	 * play scenario: each run loads the selected nodes with a new repository then goes through all the time steps.
+	 * As vtkEPCReader::RequestData does, each output is handed to an output kept between the frames
+	 * and the background task (prefetch of the next time steps) is started once the frame is ready.
+	 */
+	void runPlay(const BenchmarkOptions &p_options, std::ostringstream &p_json)
+	{
+		std::vector<double> w_framesPerSecond;
+		std::vector<double> w_frameTimes;
+		size_t w_timeStepCount = 0;
+		for (uint32_t w_index = 0; w_index < p_options._warmup + p_options._repetitions; ++w_index)
+		{
+			std::unique_ptr<ResqmlDataRepositoryToVtkPartitionedDataSetCollection> w_repository = createRepository(p_options);
+			w_repository->addFiles(p_options._files);
+			selectNodes(w_repository.get(), p_options);
+			const std::vector<double> w_timeSteps = w_repository->getTimes();
+			if (w_timeSteps.empty())
+			{
+				throw std::invalid_argument("The selected nodes have no time step.");
+			}
+			w_timeStepCount = w_timeSteps.size();
+			vtkSmartPointer<vtkPartitionedDataSetCollection> w_pipelineOutput = vtkSmartPointer<vtkPartitionedDataSetCollection>::New();
+
+			const auto w_playStart = std::chrono::steady_clock::now();
+			for (const double w_time : w_timeSteps)
+			{
+				const auto w_start = std::chrono::steady_clock::now();
+				ResqmlDataRepositoryToVtkPartitionedDataSetCollection::shallowCopy(w_repository->getVtkPartitionedDatasSetCollection(w_time), w_pipelineOutput);
+				w_repository->startBackgroundTask(w_time);
+				if (w_index >= p_options._warmup)
+				{
+					w_frameTimes.push_back(elapsedMs(w_start));
+				}
+				std::this_thread::sleep_for(std::chrono::milliseconds(p_options._frameMs));
+			}
+			if (w_index >= p_options._warmup)
+			{
+				w_framesPerSecond.push_back(w_timeSteps.size() * 1000.0 / elapsedMs(w_playStart));
+			}
+		}
+
+		p_json << ", \"timeSteps\": " << w_timeStepCount << ", \"prefetch\": " << p_options._prefetchedTimeSteps
+			   << ", \"frameMs\": " << p_options._frameMs << ", ";
+		writeSamples(p_json, "fps", w_framesPerSecond);
+		p_json << ", ";
+		writeSamples(p_json, "frame", w_frameTimes);
+	}
+
+	/**
+	 * toggle scenario: the selected nodes are loaded once, then each repetition shows and hides the toggled node.
+	 * Each update is handed to an output kept alive between updates, as vtkEPCReader::RequestData does,
+	 * and the resident memory is sampled after each of them: it should not grow with the repetitions.
+	 */
+	void runToggle(const BenchmarkOptions &p_options, std::ostringstream &p_json)
+	{
+		std::unique_ptr<ResqmlDataRepositoryToVtkPartitionedDataSetCollection> w_repository = createRepository(p_options);
+		w_repository->addFiles(p_options._files);
+		const int w_toggledNodeId = findNode(w_repository.get(), p_options._toggle);
+		const double w_time = selectedTime(w_repository.get(), p_options);
+		vtkSmartPointer<vtkPartitionedDataSetCollection> w_pipelineOutput = vtkSmartPointer<vtkPartitionedDataSetCollection>::New();
+
+		auto update = [&](bool p_withToggledNode) -> double
+		{
+			const auto w_start = std::chrono::steady_clock::now();
+			w_repository->clearSelection();
+			selectNodes(w_repository.get(), p_options);
+			if (p_withToggledNode)
+			{
+				w_repository->selectNodeId(w_toggledNodeId);
+			}
+			ResqmlDataRepositoryToVtkPartitionedDataSetCollection::shallowCopy(w_repository->getVtkPartitionedDatasSetCollection(w_time), w_pipelineOutput);
+			return elapsedMs(w_start);
+		};
+
+		update(false);
+		double w_initialResidentMB;
+		double w_initialPeakMB;
+		readMemoryUsage(w_initialResidentMB, w_initialPeakMB);
+
+		std::vector<double> w_showTimes;
+		std::vector<double> w_hideTimes;
+		std::vector<double> w_residentMB;
+		std::vector<double> w_peakMB;
+		for (uint32_t w_index = 0; w_index < p_options._warmup + p_options._repetitions; ++w_index)
+		{
+			resetPeakMemoryUsage();
+			const double w_showTime = update(true);
+			const double w_hideTime = update(false);
+			double w_resident;
+			double w_peak;
+			readMemoryUsage(w_resident, w_peak);
+			if (w_index >= p_options._warmup)
+			{
+				w_showTimes.push_back(w_showTime);
+				w_hideTimes.push_back(w_hideTime);
+				w_residentMB.push_back(w_resident);
+				w_peakMB.push_back(w_peak);
+			}
+		}
+
+		p_json << ", \"initialResidentMB\": " << w_initialResidentMB << ", ";
+		writeSamples(p_json, "show", w_showTimes);
+		p_json << ", ";
+		writeSamples(p_json, "hide", w_hideTimes);
+		p_json << ", ";
+		writeSamples(p_json, "residentMB", w_residentMB);
+		p_json << ", ";
+		writeSamples(p_json, "peakResidentMB", w_peakMB);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	BenchmarkOptions w_options;
+	if (!parseArguments(argc, argv, w_options))
+	{
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	std::ostringstream w_json;
+	w_json << std::fixed << std::setprecision(3) << "{\"scenario\": \"" << w_options._scenario << "\", \"files\": [";
+	for (size_t w_index = 0; w_index < w_options._files.size(); ++w_index)
+	{
+		w_json << (w_index == 0 ? "" : ", ") << '"' << escapeJson(w_options._files[w_index]) << '"';
+	}
+	w_json << "], \"warmup\": " << w_options._warmup
+		   << ", \"repetitions\": " << w_options._repetitions
+		   << ", \"threads\": " << w_options._numberOfThreads;
+	try
+	{
+		if (w_options._scenario == "open")
+		{
+			runOpen(w_options, w_json);
+		}
+		else if (w_options._scenario == "add")
+		{
+			runAdd(w_options, w_json);
+		}
+		else if (w_options._scenario == "play")
+		{
+			runPlay(w_options, w_json);
+		}
+		else if (w_options._scenario == "toggle")
+		{
+			runToggle(w_options, w_json);
+		}
+		else
+		{
+			runLoad(w_options, w_json);
+		}
+	}
+	catch (const std::exception &e)
+	{
+		std::cerr << "fesppBenchmark: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+	w_json << '}';
+	std::cout << w_json.str() << std::endl;
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,793 @@
+/*-----------------------------------------------------------------------
+Licensed to the Apache Software Foundation (ASF) under one
+or more contributor license agreements.  See the NOTICE file
+distributed with this work for additional information
+regarding copyright ownership.  The ASF licenses this file
+to you under the Apache License, Version 2.0 (the
+"License"; you may not use this file except in compliance
+with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+KIND, either express or implied.  See the License for the
+specific language governing permissions and limitations
+under the License.
+-----------------------------------------------------------------------*/
+
+/*
+Generator of synthetic EPC documents of configurable size (e.g. for fesppBenchmark):
+    fesppGenerateEpc [options] output.epc
+
+The document contains:
+    - an IJK grid with faults (split pillar columns), K gaps and cells without geometry,
+      a porosity, a facies and a pressure time series, written one K layer at a time;
+    - an unstructured grid mixing hexahedra, prisms and tetrahedra;
+    - wellbores with a trajectory, a frame and its log, a marker frame and a completion with perforations;
+    - triangulated surfaces made of several patches.
+The uuids are derived from a seed: the same options give the same document.
+*/
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "fesapi/common/DataObjectRepository.h"
+#include "fesapi/common/EpcDocument.h"
+#include "fesapi/eml2/AbstractHdfProxy.h"
+#include "fesapi/eml2/TimeSeries.h"
+#include "fesapi/resqml2/BoundaryFeature.h"
+#include "fesapi/resqml2/ContinuousProperty.h"
+#include "fesapi/resqml2/DiscreteProperty.h"
+#include "fesapi/resqml2/HorizonInterpretation.h"
+#include "fesapi/resqml2/IjkGridExplicitRepresentation.h"
+#include "fesapi/resqml2/LocalDepth3dCrs.h"
+#include "fesapi/resqml2/MdDatum.h"
+#include "fesapi/resqml2/TriangulatedSetRepresentation.h"
+#include "fesapi/resqml2/UnstructuredGridRepresentation.h"
+#include "fesapi/resqml2/WellboreFeature.h"
+#include "fesapi/resqml2/WellboreFrameRepresentation.h"
+#include "fesapi/resqml2/WellboreInterpretation.h"
+#include "fesapi/resqml2/WellboreMarker.h"
+#include "fesapi/resqml2/WellboreMarkerFrameRepresentation.h"
+#include "fesapi/resqml2/WellboreTrajectoryRepresentation.h"
+#include "fesapi/resqml2_0_1/PropertyKind.h"
+#include "fesapi/witsml2_1/Well.h"
+#include "fesapi/witsml2_1/WellCompletion.h"
+#include "fesapi/witsml2_1/Wellbore.h"
+#include "fesapi/witsml2_1/WellboreCompletion.h"
+
+namespace
+{
+	struct GeneratorOptions
+	{
+		std::string _fileName;
+		uint32_t _iCellCount = 50;
+		uint32_t _jCellCount = 50;
+		uint32_t _kCellCount = 20;
+		// faults of the IJK grid, evenly spaced along I
+		uint32_t _faultCount = 1;
+		// the unstructured grid is built from a lattice of _unstructuredSize^3 hexahedra
+		uint32_t _unstructuredSize = 20;
+		uint32_t _wellboreCount = 1000;
+		uint32_t _surfaceCount = 10;
+		uint32_t _patchCount = 4;
+		// node count along each side of a surface patch
+		uint32_t _patchSize = 50;
+		uint32_t _timeStepCount = 200;
+		uint64_t _seed = 0;
+	};
+
+	// size of the cells and of the area covered by the objects
+	const double CELL_SIZE = 100.0;
+	const double LAYER_THICKNESS = 5.0;
+	const double TOP_DEPTH = 1000.0;
+	const double FAULT_THROW = 20.0;
+	const double K_GAP_THICKNESS = 2.0;
+	// a K gap after every K_GAP_PERIOD layers
+	const uint32_t K_GAP_PERIOD = 10;
+
+	/**
+	 * deterministic version 4 uuids (splitmix64 sequence from a seed)
+	 */
+	class UuidGenerator
+	{
+	public:
+		explicit UuidGenerator(uint64_t p_seed) : _state(p_seed) {}
+
+		std::string next()
+		{
+			uint64_t w_high = nextValue();
+			uint64_t w_low = nextValue();
+			// version 4 and RFC 4122 variant
+			w_high = (w_high & 0xFFFFFFFFFFFF0FFFULL) | 0x0000000000004000ULL;
+			w_low = (w_low & 0x3FFFFFFFFFFFFFFFULL) | 0x8000000000000000ULL;
+			std::ostringstream w_uuid;
+			w_uuid << std::hex << std::setfill('0')
+				   << std::setw(8) << (w_high >> 32) << '-' << std::setw(4) << ((w_high >> 16) & 0xFFFF) << '-' << std::setw(4) << (w_high & 0xFFFF) << '-'
+				   << std::setw(4) << (w_low >> 48) << '-' << std::setw(12) << (w_low & 0xFFFFFFFFFFFFULL);
+			return w_uuid.str();
+		}
+
+	private:
+		uint64_t nextValue()
+		{
+			uint64_t w_value = (_state += 0x9E3779B97F4A7C15ULL);
+			w_value = (w_value ^ (w_value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			w_value = (w_value ^ (w_value >> 27)) * 0x94D049BB133111EBULL;
+			return w_value ^ (w_value >> 31);
+		}
+
+		uint64_t _state;
+	};
+
+	struct Context
+	{
+		UuidGenerator *_uuids;
+		COMMON_NS::DataObjectRepository *_repository;
+		EML2_NS::AbstractHdfProxy *_hdfProxy;
+		RESQML2_NS::LocalDepth3dCrs *_crs;
+		RESQML2_0_1_NS::PropertyKind *_continuousPropertyKind;
+		RESQML2_0_1_NS::PropertyKind *_discretePropertyKind;
+	};
+
+	void printUsage()
+	{
+		std::cerr << "Usage: fesppGenerateEpc [options] output.epc\n"
+				  << "  --ijk NI NJ NK       cell counts of the IJK grid (default 50 50 20)\n"
+				  << "  --faults N           faults of the IJK grid, evenly spaced along I (less than NI, default 1)\n"
+				  << "  --unstructured N     the unstructured grid is built from N x N x N hexahedra (default 20)\n"
+				  << "  --wellbores N        wellbores with frame, markers and completion (default 1000)\n"
+				  << "  --surfaces N         triangulated surfaces (default 10)\n"
+				  << "  --patches N          patches per surface (default 4)\n"
+				  << "  --patch-size N       nodes along each side of a patch (default 50)\n"
+				  << "  --time-steps N       time steps of the pressure of the IJK grid (default 200)\n"
+				  << "  --seed N             seed of the uuids (default 0)\n";
+	}
+
+	bool parseUnsigned(const char *p_value, uint32_t &p_result)
+	{
+		char *w_end = nullptr;
+		const unsigned long w_value = std::strtoul(p_value, &w_end, 10);
+		if (w_end == p_value || *w_end != '\0')
+		{
+			return false;
+		}
+		p_result = static_cast<uint32_t>(w_value);
+		return true;
+	}
+
+	bool parseArguments(int p_argc, char *p_argv[], GeneratorOptions &p_options)
+	{
+		for (int w_index = 1; w_index < p_argc; ++w_index)
+		{
+			const std::string w_argument = p_argv[w_index];
+			bool w_valid = true;
+			if (w_argument == "--ijk" && w_index + 3 < p_argc)
+			{
+				w_valid = parseUnsigned(p_argv[++w_index], p_options._iCellCount) &&
+						  parseUnsigned(p_argv[++w_index], p_options._jCellCount) &&
+						  parseUnsigned(p_argv[++w_index], p_options._kCellCount);
+			}
+			else if (w_argument == "--faults" && w_index + 1 < p_argc)
+			{
+				w_valid = parseUnsigned(p_argv[++w_index], p_options._faultCount);
+			}
+			else if (w_argument == "--seed" && w_index + 1 < p_argc)
+			{
+				char *w_end = nullptr;
+				const char *w_value = p_argv[++w_index];
+				p_options._seed = std::strtoull(w_value, &w_end, 10);
+				w_valid = w_end != w_value && *w_end == '\0';
+			}
+			else if (w_argument == "--unstructured" && w_index + 1 < p_argc)
+			{
+				w_valid = parseUnsigned(p_argv[++w_index], p_options._unstructuredSize);
+			}
+			else if (w_argument == "--wellbores" && w_index + 1 < p_argc)
+			{
+				w_valid = parseUnsigned(p_argv[++w_index], p_options._wellboreCount);
+			}
+			else if (w_argument == "--surfaces" && w_index + 1 < p_argc)
+			{
+				w_valid = parseUnsigned(p_argv[++w_index], p_options._surfaceCount);
+			}
+			else if (w_argument == "--patches" && w_index + 1 < p_argc)
+			{
+				w_valid = parseUnsigned(p_argv[++w_index], p_options._patchCount) && p_options._patchCount > 0;
+			}
+			else if (w_argument == "--patch-size" && w_index + 1 < p_argc)
+			{
+				w_valid = parseUnsigned(p_argv[++w_index], p_options._patchSize) && p_options._patchSize > 1;
+			}
+			else if (w_argument == "--time-steps" && w_index + 1 < p_argc)
+			{
+				w_valid = parseUnsigned(p_argv[++w_index], p_options._timeStepCount);
+			}
+			else if (w_argument.compare(0, 2, "--") == 0 || !p_options._fileName.empty())
+			{
+				w_valid = false;
+			}
+			else
+			{
+				p_options._fileName = w_argument;
+			}
+			if (!w_valid)
+			{
+				return false;
+			}
+		}
+		// each fault is on its own pillar column, strictly inside the grid
+		return !p_options._fileName.empty() && p_options._iCellCount > p_options._faultCount && p_options._jCellCount > 0 && p_options._kCellCount > 0;
+	}
+
+	/**
+	 * @return the depth of a horizon at (p_x, p_y): a gentle anticline
+	 */
+	double getDepth(double p_x, double p_y)
+	{
+		return TOP_DEPTH - 30.0 * std::sin(p_x / 1500.0) * std::cos(p_y / 2000.0);
+	}
+
+	/**
+	 * depth offset of each pillar column: FAULT_THROW more on the east side of each fault
+	 */
+	std::vector<double> getPillarThrows(uint32_t p_iCount, const std::vector<uint32_t> &p_iFaults)
+	{
+		std::vector<double> w_throws(p_iCount + 1, 0.0);
+		for (uint32_t w_i = 0; w_i <= p_iCount; ++w_i)
+		{
+			w_throws[w_i] = FAULT_THROW * std::count_if(p_iFaults.begin(), p_iFaults.end(), [w_i](uint32_t p_iFault) -> bool
+														{ return p_iFault < w_i; });
+		}
+		return w_throws;
+	}
+
+	/**
+	 * IJK grid: a fault along the pillars of each column I = (f + 1) * iCellCount / (faultCount + 1) (the cells on its east side
+	 * use split coordinate lines shifted by FAULT_THROW), a K gap after every K_GAP_PERIOD layers and some cells without geometry.
+	 * The geometry and the properties are written one K interface/layer at a time through hyperslabs: only one layer is in memory.
+	 */
+	RESQML2_NS::IjkGridExplicitRepresentation *generateIjkGrid(const Context &p_context, const GeneratorOptions &p_options)
+	{
+		const uint32_t w_iCount = p_options._iCellCount;
+		const uint32_t w_jCount = p_options._jCellCount;
+		const uint32_t w_kCount = p_options._kCellCount;
+		const uint64_t w_layerCellCount = static_cast<uint64_t>(w_iCount) * w_jCount;
+
+		std::unique_ptr<bool[]> w_kGaps(new bool[w_kCount > 1 ? w_kCount - 1 : 1]);
+		uint32_t w_kGapCount = 0;
+		for (uint32_t w_k = 0; w_k + 1 < w_kCount; ++w_k)
+		{
+			w_kGaps[w_k] = (w_k + 1) % K_GAP_PERIOD == 0;
+			w_kGapCount += w_kGaps[w_k] ? 1 : 0;
+		}
+
+		// depth offset of each K interface from the top horizon
+		std::vector<double> w_interfaceOffsets;
+		w_interfaceOffsets.reserve(w_kCount + 1 + w_kGapCount);
+		double w_offset = 0.0;
+		w_interfaceOffsets.push_back(w_offset);
+		for (uint32_t w_k = 0; w_k < w_kCount; ++w_k)
+		{
+			w_offset += LAYER_THICKNESS;
+			w_interfaceOffsets.push_back(w_offset);
+			if (w_k + 1 < w_kCount && w_kGaps[w_k])
+			{
+				w_offset += K_GAP_THICKNESS;
+				w_interfaceOffsets.push_back(w_offset);
+			}
+		}
+
+		// split coordinate lines: one per pillar of each fault, used by the columns on its east side
+		std::vector<uint32_t> w_iFaults;
+		for (uint32_t w_fault = 0; w_fault < p_options._faultCount; ++w_fault)
+		{
+			w_iFaults.push_back(static_cast<uint32_t>((w_fault + 1) * static_cast<uint64_t>(w_iCount) / (p_options._faultCount + 1)));
+		}
+		const std::vector<double> w_pillarThrows = getPillarThrows(w_iCount, w_iFaults);
+		std::vector<uint32_t> w_pillarOfCoordinateLine;
+		std::vector<uint32_t> w_splitCoordinateLineColumnCumulativeCount;
+		std::vector<uint32_t> w_splitCoordinateLineColumns;
+		for (const uint32_t w_iFault : w_iFaults)
+		{
+			for (uint32_t w_j = 0; w_j <= w_jCount; ++w_j)
+			{
+				w_pillarOfCoordinateLine.push_back(w_iFault + w_j * (w_iCount + 1));
+				if (w_j > 0)
+				{
+					w_splitCoordinateLineColumns.push_back(w_iFault + (w_j - 1) * w_iCount);
+				}
+				if (w_j < w_jCount)
+				{
+					w_splitCoordinateLineColumns.push_back(w_iFault + w_j * w_iCount);
+				}
+				w_splitCoordinateLineColumnCumulativeCount.push_back(static_cast<uint32_t>(w_splitCoordinateLineColumns.size()));
+			}
+		}
+
+		RESQML2_NS::IjkGridExplicitRepresentation *w_ijkGrid = p_context._repository->createIjkGridExplicitRepresentation(p_context._uuids->next(), "Faulted IJK grid", w_iCount, w_jCount, w_kCount, w_kCount > 1 ? w_kGaps.get() : nullptr);
+		const std::string w_groupName = w_ijkGrid->getUuid();
+		const std::string w_groupPath = "/RESQML/" + w_groupName + '/';
+		EML2_NS::AbstractHdfProxy *const w_hdfProxy = p_context._hdfProxy;
+
+		// points: interface by interface
+		const uint64_t w_pillarCount = static_cast<uint64_t>(w_iCount + 1) * (w_jCount + 1);
+		const uint64_t w_interfaceNodeCount = w_pillarCount + w_pillarOfCoordinateLine.size();
+		const uint64_t w_pointsDimensions[3] = {w_interfaceOffsets.size(), w_interfaceNodeCount, 3};
+		w_hdfProxy->createArrayNd(w_groupName, "Points", COMMON_NS::AbstractObject::numericalDatatypeEnum::DOUBLE, w_pointsDimensions, 3);
+		std::vector<double> w_interfacePoints;
+		w_interfacePoints.reserve(w_interfaceNodeCount * 3);
+		for (size_t w_interfaceIndex = 0; w_interfaceIndex < w_interfaceOffsets.size(); ++w_interfaceIndex)
+		{
+			const double w_interfaceOffset = w_interfaceOffsets[w_interfaceIndex];
+			w_interfacePoints.clear();
+			for (uint32_t w_j = 0; w_j <= w_jCount; ++w_j)
+			{
+				for (uint32_t w_i = 0; w_i <= w_iCount; ++w_i)
+				{
+					const double w_x = w_i * CELL_SIZE;
+					const double w_y = w_j * CELL_SIZE;
+					w_interfacePoints.push_back(w_x);
+					w_interfacePoints.push_back(w_y);
+					w_interfacePoints.push_back(getDepth(w_x, w_y) + w_interfaceOffset + w_pillarThrows[w_i]);
+				}
+			}
+			for (const uint32_t w_pillarIndex : w_pillarOfCoordinateLine)
+			{
+				const uint32_t w_i = w_pillarIndex % (w_iCount + 1);
+				const double w_x = w_i * CELL_SIZE;
+				const double w_y = (w_pillarIndex / (w_iCount + 1)) * CELL_SIZE;
+				w_interfacePoints.push_back(w_x);
+				w_interfacePoints.push_back(w_y);
+				w_interfacePoints.push_back(getDepth(w_x, w_y) + w_interfaceOffset + w_pillarThrows[w_i] + FAULT_THROW);
+			}
+			const uint64_t w_slabCounts[3] = {1, w_interfaceNodeCount, 3};
+			const uint64_t w_slabOffsets[3] = {w_interfaceIndex, 0, 0};
+			w_hdfProxy->writeArrayNdSlab(w_groupName, "Points", COMMON_NS::AbstractObject::numericalDatatypeEnum::DOUBLE, w_interfacePoints.data(), w_slabCounts, w_slabOffsets, 3);
+		}
+
+		if (w_pillarOfCoordinateLine.empty())
+		{
+			w_ijkGrid->setGeometryAsCoordinateLineNodesUsingExistingDatasets(gsoap_resqml2_0_1::resqml20__PillarShape::vertical, gsoap_resqml2_0_1::resqml20__KDirection::down, false,
+																			 w_groupPath + "Points", w_hdfProxy);
+		}
+		else
+		{
+			const uint64_t w_splitCount = w_pillarOfCoordinateLine.size();
+			const uint64_t w_splitColumnCount = w_splitCoordinateLineColumns.size();
+			w_hdfProxy->writeArrayNd(w_groupName, "PillarIndices", COMMON_NS::AbstractObject::numericalDatatypeEnum::UINT32, w_pillarOfCoordinateLine.data(), &w_splitCount, 1);
+			w_hdfProxy->writeArrayNd(w_groupName, "ColumnsPerSplitCoordinateLine_cumulativeLength", COMMON_NS::AbstractObject::numericalDatatypeEnum::UINT32, w_splitCoordinateLineColumnCumulativeCount.data(), &w_splitCount, 1);
+			w_hdfProxy->writeArrayNd(w_groupName, "ColumnsPerSplitCoordinateLine_elements", COMMON_NS::AbstractObject::numericalDatatypeEnum::UINT32, w_splitCoordinateLineColumns.data(), &w_splitColumnCount, 1);
+			w_ijkGrid->setGeometryAsCoordinateLineNodesUsingExistingDatasets(gsoap_resqml2_0_1::resqml20__PillarShape::vertical, gsoap_resqml2_0_1::resqml20__KDirection::down, false,
+																			 w_groupPath + "Points", w_hdfProxy,
+																			 w_splitCount, w_groupPath + "PillarIndices",
+																			 w_groupPath + "ColumnsPerSplitCoordinateLine_cumulativeLength", w_groupPath + "ColumnsPerSplitCoordinateLine_elements");
+		}
+
+		// cells without geometry (a block in a corner and a sparse pattern), porosity and facies: layer by layer
+		const uint64_t w_cellDimensions[3] = {w_kCount, w_jCount, w_iCount};
+		w_hdfProxy->createArrayNd(w_groupName, "CellGeometryIsDefined", COMMON_NS::AbstractObject::numericalDatatypeEnum::UINT8, w_cellDimensions, 3);
+		RESQML2_NS::ContinuousProperty *w_porosityProperty = p_context._repository->createContinuousProperty(w_ijkGrid, p_context._uuids->next(), "Porosity", 1, gsoap_eml2_3::eml23__IndexableElement::cells, gsoap_resqml2_0_1::resqml20__ResqmlUom::Euc, p_context._continuousPropertyKind);
+		w_porosityProperty->pushBackHdf5Array3dOfValues(COMMON_NS::AbstractObject::numericalDatatypeEnum::DOUBLE, w_iCount, w_jCount, w_kCount, w_hdfProxy);
+		RESQML2_NS::DiscreteProperty *w_faciesProperty = p_context._repository->createDiscreteProperty(w_ijkGrid, p_context._uuids->next(), "Facies", 1, gsoap_eml2_3::eml23__IndexableElement::cells, p_context._discretePropertyKind);
+		w_faciesProperty->pushBackHdf5Array3dOfValues(COMMON_NS::AbstractObject::numericalDatatypeEnum::INT32, w_iCount, w_jCount, w_kCount, (std::numeric_limits<int32_t>::max)(), w_hdfProxy);
+
+		std::unique_ptr<uint8_t[]> w_cellGeometryIsDefined(new uint8_t[w_layerCellCount]);
+		std::vector<double> w_porosity(w_layerCellCount);
+		std::vector<int32_t> w_facies(w_layerCellCount);
+		for (uint32_t w_k = 0; w_k < w_kCount; ++w_k)
+		{
+			for (uint32_t w_j = 0; w_j < w_jCount; ++w_j)
+			{
+				for (uint32_t w_i = 0; w_i < w_iCount; ++w_i)
+				{
+					const uint64_t w_layerCellIndex = w_i + static_cast<uint64_t>(w_j) * w_iCount;
+					const uint64_t w_cellIndex = w_layerCellIndex + w_k * w_layerCellCount;
+					const bool w_inCorner = w_i < w_iCount / 5 && w_j < w_jCount / 5;
+					const bool w_inPattern = (w_i * 7 + w_j * 13 + w_k * 3) % 17 == 0;
+					w_cellGeometryIsDefined[w_layerCellIndex] = w_inCorner || w_inPattern ? 0 : 1;
+					w_porosity[w_layerCellIndex] = 0.1 + 0.2 * std::abs(std::sin(w_cellIndex * 0.001));
+				}
+			}
+			std::fill(w_facies.begin(), w_facies.end(), static_cast<int32_t>(w_k % 4));
+
+			const uint64_t w_slabCounts[3] = {1, w_jCount, w_iCount};
+			const uint64_t w_slabOffsets[3] = {w_k, 0, 0};
+			w_hdfProxy->writeArrayNdSlab(w_groupName, "CellGeometryIsDefined", COMMON_NS::AbstractObject::numericalDatatypeEnum::UINT8, w_cellGeometryIsDefined.get(), w_slabCounts, w_slabOffsets, 3);
+			w_porosityProperty->setValuesOfDoubleHdf5Array3dOfValues(w_porosity.data(), w_iCount, w_jCount, 1, 0, 0, w_k, w_hdfProxy);
+			w_faciesProperty->setValuesOfInt32Hdf5Array3dOfValues(w_facies.data(), w_iCount, w_jCount, 1, 0, 0, w_k, w_hdfProxy);
+		}
+		w_ijkGrid->setCellGeometryIsDefinedFlagsUsingExistingDataset(w_groupPath + "CellGeometryIsDefined", w_hdfProxy);
+
+		return w_ijkGrid;
+	}
+
+	/**
+	 * pressure of the IJK grid at each time step of a time series (one property per time step, written layer by layer)
+	 */
+	void generateTimeSeries(const Context &p_context, const GeneratorOptions &p_options, RESQML2_NS::IjkGridExplicitRepresentation *p_ijkGrid)
+	{
+		if (p_options._timeStepCount == 0)
+		{
+			return;
+		}
+
+		EML2_NS::TimeSeries *w_timeSeries = p_context._repository->createTimeSeries(p_context._uuids->next(), "Monthly time series");
+		// 2020-01-01 then every 30 days
+		const time_t w_firstTimestamp = 1577836800;
+		for (uint32_t w_step = 0; w_step < p_options._timeStepCount; ++w_step)
+		{
+			w_timeSeries->pushBackTimestamp(w_firstTimestamp + static_cast<time_t>(w_step) * 30 * 24 * 3600);
+		}
+
+		const uint32_t w_iCount = p_ijkGrid->getICellCount();
+		const uint32_t w_jCount = p_ijkGrid->getJCellCount();
+		const uint32_t w_kCount = p_ijkGrid->getKCellCount();
+		const uint64_t w_layerCellCount = static_cast<uint64_t>(w_iCount) * w_jCount;
+		std::vector<double> w_pressure(w_layerCellCount);
+		for (uint32_t w_step = 0; w_step < p_options._timeStepCount; ++w_step)
+		{
+			RESQML2_NS::ContinuousProperty *w_property = p_context._repository->createContinuousProperty(p_ijkGrid, p_context._uuids->next(), "Pressure", 1, gsoap_eml2_3::eml23__IndexableElement::cells, gsoap_resqml2_0_1::resqml20__ResqmlUom::Euc, p_context._continuousPropertyKind);
+			w_property->setTimeSeries(w_timeSeries);
+			w_property->setSingleTimestamp(w_timeSeries->getTimestamp(w_step));
+			w_property->pushBackHdf5Array3dOfValues(COMMON_NS::AbstractObject::numericalDatatypeEnum::DOUBLE, w_iCount, w_jCount, w_kCount, p_context._hdfProxy);
+			for (uint32_t w_k = 0; w_k < w_kCount; ++w_k)
+			{
+				for (uint64_t w_layerCellIndex = 0; w_layerCellIndex < w_layerCellCount; ++w_layerCellIndex)
+				{
+					const uint64_t w_cellIndex = w_layerCellIndex + w_k * w_layerCellCount;
+					w_pressure[w_layerCellIndex] = 300.0 - 0.5 * w_step + 10.0 * std::sin(w_cellIndex * 0.01 + w_step * 0.1);
+				}
+				w_property->setValuesOfDoubleHdf5Array3dOfValues(w_pressure.data(), w_iCount, w_jCount, 1, 0, 0, w_k, p_context._hdfProxy);
+			}
+		}
+	}
+
+	/**
+	 * faces of the polyhedral cells of an unstructured grid (the faces are not shared between cells)
+	 */
+	struct UnstructuredGridTopology
+	{
+		std::vector<uint64_t> _nodeIndicesPerFace;
+		std::vector<uint64_t> _nodeIndicesCumulativeCountPerFace;
+		std::vector<uint64_t> _faceIndicesPerCell;
+		std::vector<uint64_t> _faceIndicesCumulativeCountPerCell;
+		std::vector<uint8_t> _faceRightHandness;
+
+		/**
+		 * add a cell from the node indices of its VTK cell and the local node indices of its faces
+		 * (same faces and right handness as vtkEPCWriter)
+		 */
+		void addCell(const std::vector<uint64_t> &p_cellNodes, const std::vector<std::vector<uint32_t>> &p_faces, const std::vector<uint8_t> &p_rightHandness)
+		{
+			for (size_t w_faceIndex = 0; w_faceIndex < p_faces.size(); ++w_faceIndex)
+			{
+				for (const uint32_t w_localNode : p_faces[w_faceIndex])
+				{
+					_nodeIndicesPerFace.push_back(p_cellNodes[w_localNode]);
+				}
+				_nodeIndicesCumulativeCountPerFace.push_back(_nodeIndicesPerFace.size());
+				_faceIndicesPerCell.push_back(_faceIndicesPerCell.size());
+				_faceRightHandness.push_back(p_rightHandness[w_faceIndex]);
+			}
+			_faceIndicesCumulativeCountPerCell.push_back(_faceIndicesPerCell.size());
+		}
+	};
+
+	/**
+	 * unstructured grid: a lattice of hexahedra, some of them split into two prisms or five tetrahedra
+	 */
+	RESQML2_NS::UnstructuredGridRepresentation *generateUnstructuredGrid(const Context &p_context, const GeneratorOptions &p_options)
+	{
+		static const std::vector<std::vector<uint32_t>> HEXAHEDRON_FACES = {{0, 1, 2, 3}, {4, 5, 6, 7}, {0, 4, 5, 1}, {1, 5, 6, 2}, {2, 6, 7, 3}, {3, 7, 4, 0}};
+		static const std::vector<uint8_t> HEXAHEDRON_RIGHT_HANDNESS = {0, 0, 1, 1, 1, 1};
+		static const std::vector<std::vector<uint32_t>> WEDGE_FACES = {{2, 1, 0}, {5, 3, 4}, {0, 1, 4, 3}, {1, 4, 5, 2}, {2, 5, 3, 0}};
+		static const std::vector<uint8_t> WEDGE_RIGHT_HANDNESS = {0, 0, 1, 1, 1};
+		static const std::vector<std::vector<uint32_t>> TETRA_FACES = {{0, 1, 2}, {0, 1, 3}, {1, 2, 3}, {0, 2, 3}};
+		static const std::vector<uint8_t> TETRA_RIGHT_HANDNESS = {1, 1, 1, 1};
+		// hexahedron split along the diagonal 0-2 of its bottom face, and into five tetrahedra
+		static const std::array<std::array<uint32_t, 6>, 2> HEXAHEDRON_WEDGES = {{{{0, 1, 2, 4, 5, 6}}, {{0, 2, 3, 4, 6, 7}}}};
+		static const std::array<std::array<uint32_t, 4>, 5> HEXAHEDRON_TETRAS = {{{{0, 1, 3, 4}}, {{1, 2, 3, 6}}, {{1, 4, 5, 6}}, {{3, 4, 6, 7}}, {{1, 3, 4, 6}}}};
+
+		const uint32_t w_size = p_options._unstructuredSize;
+		const uint32_t w_nodeCountPerSide = w_size + 1;
+		// the grid is located east of the IJK grid
+		const double w_xOrigin = (p_options._iCellCount + 10) * CELL_SIZE;
+
+		std::vector<double> w_points;
+		w_points.reserve(static_cast<size_t>(w_nodeCountPerSide) * w_nodeCountPerSide * w_nodeCountPerSide * 3);
+		for (uint32_t w_k = 0; w_k < w_nodeCountPerSide; ++w_k)
+		{
+			for (uint32_t w_j = 0; w_j < w_nodeCountPerSide; ++w_j)
+			{
+				for (uint32_t w_i = 0; w_i < w_nodeCountPerSide; ++w_i)
+				{
+					w_points.push_back(w_xOrigin + w_i * CELL_SIZE);
+					w_points.push_back(w_j * CELL_SIZE);
+					w_points.push_back(TOP_DEPTH + w_k * LAYER_THICKNESS * 4);
+				}
+			}
+		}
+
+		const auto w_nodeIndex = [w_nodeCountPerSide](uint32_t p_i, uint32_t p_j, uint32_t p_k) -> uint64_t
+		{
+			return p_i + (p_j + static_cast<uint64_t>(p_k) * w_nodeCountPerSide) * w_nodeCountPerSide;
+		};
+
+		UnstructuredGridTopology w_topology;
+		uint64_t w_cellCount = 0;
+		std::vector<uint64_t> w_subCellNodes;
+		for (uint32_t w_k = 0; w_k < w_size; ++w_k)
+		{
+			for (uint32_t w_j = 0; w_j < w_size; ++w_j)
+			{
+				for (uint32_t w_i = 0; w_i < w_size; ++w_i)
+				{
+					// VTK hexahedron order: bottom face then top face
+					const std::vector<uint64_t> w_hexahedronNodes = {
+						w_nodeIndex(w_i, w_j, w_k), w_nodeIndex(w_i + 1, w_j, w_k), w_nodeIndex(w_i + 1, w_j + 1, w_k), w_nodeIndex(w_i, w_j + 1, w_k),
+						w_nodeIndex(w_i, w_j, w_k + 1), w_nodeIndex(w_i + 1, w_j, w_k + 1), w_nodeIndex(w_i + 1, w_j + 1, w_k + 1), w_nodeIndex(w_i, w_j + 1, w_k + 1)};
+					switch ((w_i + w_j + w_k) % 3)
+					{
+					case 0:
+						w_topology.addCell(w_hexahedronNodes, HEXAHEDRON_FACES, HEXAHEDRON_RIGHT_HANDNESS);
+						++w_cellCount;
+						break;
+					case 1:
+						for (const auto &w_wedge : HEXAHEDRON_WEDGES)
+						{
+							w_subCellNodes.clear();
+							for (const uint32_t w_localNode : w_wedge)
+							{
+								w_subCellNodes.push_back(w_hexahedronNodes[w_localNode]);
+							}
+							w_topology.addCell(w_subCellNodes, WEDGE_FACES, WEDGE_RIGHT_HANDNESS);
+							++w_cellCount;
+						}
+						break;
+					default:
+						for (const auto &w_tetra : HEXAHEDRON_TETRAS)
+						{
+							w_subCellNodes.clear();
+							for (const uint32_t w_localNode : w_tetra)
+							{
+								w_subCellNodes.push_back(w_hexahedronNodes[w_localNode]);
+							}
+							w_topology.addCell(w_subCellNodes, TETRA_FACES, TETRA_RIGHT_HANDNESS);
+							++w_cellCount;
+						}
+						break;
+					}
+				}
+			}
+		}
+
+		RESQML2_NS::UnstructuredGridRepresentation *w_unstructuredGrid = p_context._repository->createUnstructuredGridRepresentation(p_context._uuids->next(), "Mixed unstructured grid", w_cellCount);
+		w_unstructuredGrid->setGeometry(w_topology._faceRightHandness.data(), w_points.data(), w_points.size() / 3, p_context._hdfProxy,
+										w_topology._faceIndicesPerCell.data(), w_topology._faceIndicesCumulativeCountPerCell.data(), w_topology._faceIndicesPerCell.size(),
+										w_topology._nodeIndicesPerFace.data(), w_topology._nodeIndicesCumulativeCountPerFace.data(),
+										gsoap_resqml2_0_1::resqml20__CellShape::polyhedral);
+
+		std::vector<double> w_cellValues(w_cellCount);
+		for (uint64_t w_cellIndex = 0; w_cellIndex < w_cellCount; ++w_cellIndex)
+		{
+			w_cellValues[w_cellIndex] = static_cast<double>(w_cellIndex % 100);
+		}
+		RESQML2_NS::ContinuousProperty *w_property = p_context._repository->createContinuousProperty(w_unstructuredGrid, p_context._uuids->next(), "Cell value", 1, gsoap_eml2_3::eml23__IndexableElement::cells, gsoap_resqml2_0_1::resqml20__ResqmlUom::Euc, p_context._continuousPropertyKind);
+		w_property->pushBackDoubleHdf5Array1dOfValues(w_cellValues.data(), w_cellCount, p_context._hdfProxy);
+
+		return w_unstructuredGrid;
+	}
+
+	/**
+	 * a deviated wellbore: trajectory, frame with a gamma ray log, marker frame and a WITSML completion with perforations
+	 */
+	void generateWellbore(const Context &p_context, uint32_t p_wellboreIndex, double p_x, double p_y)
+	{
+		const std::string w_name = "Wellbore " + std::to_string(p_wellboreIndex);
+		const uint32_t w_stationCount = 20;
+		const double w_stationSpacing = 75.0;
+
+		// vertical down to the kick off point, then deviated toward the north east
+		std::vector<double> w_controlPoints;
+		std::vector<double> w_mds;
+		double w_md = 0.0;
+		double w_x = p_x;
+		double w_y = p_y;
+		double w_z = 0.0;
+		for (uint32_t w_station = 0; w_station < w_stationCount; ++w_station)
+		{
+			w_controlPoints.push_back(w_x);
+			w_controlPoints.push_back(w_y);
+			w_controlPoints.push_back(w_z);
+			w_mds.push_back(w_md);
+
+			const double w_inclination = w_station < w_stationCount / 2 ? 0.0 : (w_station - w_stationCount / 2) * 0.05;
+			w_x += w_stationSpacing * std::sin(w_inclination) * 0.7071;
+			w_y += w_stationSpacing * std::sin(w_inclination) * 0.7071;
+			w_z += w_stationSpacing * std::cos(w_inclination);
+			w_md += w_stationSpacing;
+		}
+		const double w_totalMd = w_mds.back();
+
+		// WITSML well, wellbore and completion
+		auto *w_witsmlWell = p_context._repository->createWell(p_context._uuids->next(), w_name, false);
+		auto *w_witsmlWellbore = p_context._repository->createWellbore(w_witsmlWell, p_context._uuids->next(), w_name, false);
+		auto *w_wellCompletion = p_context._repository->createWellCompletion(w_witsmlWell, p_context._uuids->next(), w_name + " completion");
+		auto *w_wellboreCompletion = p_context._repository->createWellboreCompletion(w_witsmlWellbore, w_wellCompletion, p_context._uuids->next(), w_name + " completion", w_name + " completion");
+		for (uint32_t w_perforation = 0; w_perforation < 3; ++w_perforation)
+		{
+			const double w_topMd = w_totalMd - 300.0 + w_perforation * 100.0;
+			w_wellboreCompletion->pushBackPerforation("MSL", gsoap_eml2_3::eml23__LengthUom::m, w_topMd, w_topMd + 40.0, "Perforation" + std::to_string(w_perforation));
+		}
+
+		// RESQML wellbore
+		RESQML2_NS::WellboreFeature *w_wellbore = p_context._repository->createWellboreFeature(p_context._uuids->next(), w_name);
+		w_wellbore->setWitsmlWellbore(w_witsmlWellbore);
+		RESQML2_NS::WellboreInterpretation *w_interpretation = p_context._repository->createWellboreInterpretation(w_wellbore, p_context._uuids->next(), w_name, false);
+		RESQML2_NS::MdDatum *w_mdDatum = p_context._repository->createMdDatum(p_context._uuids->next(), w_name + " datum", p_context._crs, gsoap_eml2_3::eml23__ReferencePointKind::mean_x0020sea_x0020level, p_x, p_y, 0.0);
+		RESQML2_NS::WellboreTrajectoryRepresentation *w_trajectory = p_context._repository->createWellboreTrajectoryRepresentation(w_interpretation, p_context._uuids->next(), w_name + " trajectory", w_mdDatum);
+		w_trajectory->setGeometry(w_controlPoints.data(), w_mds.data(), w_stationCount, 0, p_context._hdfProxy);
+
+		// frame: a log sample every 10 m
+		std::vector<double> w_frameMds;
+		std::vector<double> w_gammaRay;
+		for (double w_frameMd = 0.0; w_frameMd <= w_totalMd; w_frameMd += 10.0)
+		{
+			w_frameMds.push_back(w_frameMd);
+			w_gammaRay.push_back(60.0 + 40.0 * std::sin(w_frameMd / 50.0 + p_wellboreIndex));
+		}
+		RESQML2_NS::WellboreFrameRepresentation *w_frame = p_context._repository->createWellboreFrameRepresentation(w_interpretation, p_context._uuids->next(), w_name + " frame", w_trajectory);
+		w_frame->setMdValues(w_frameMds.data(), w_frameMds.size(), p_context._hdfProxy);
+		RESQML2_NS::ContinuousProperty *w_log = p_context._repository->createContinuousProperty(w_frame, p_context._uuids->next(), "Gamma ray", 1, gsoap_eml2_3::eml23__IndexableElement::nodes, gsoap_resqml2_0_1::resqml20__ResqmlUom::Euc, p_context._continuousPropertyKind);
+		w_log->pushBackDoubleHdf5Array1dOfValues(w_gammaRay.data(), w_gammaRay.size(), p_context._hdfProxy);
+
+		// markers along the deviated part
+		const uint32_t w_markerCount = 5;
+		std::vector<double> w_markerMds;
+		for (uint32_t w_marker = 0; w_marker < w_markerCount; ++w_marker)
+		{
+			w_markerMds.push_back(w_totalMd / 2 + (w_marker + 1) * w_totalMd / (2 * (w_markerCount + 1)));
+		}
+		RESQML2_NS::WellboreMarkerFrameRepresentation *w_markerFrame = p_context._repository->createWellboreMarkerFrameRepresentation(w_interpretation, p_context._uuids->next(), w_name + " markers", w_trajectory);
+		w_markerFrame->setMdValues(w_markerMds.data(), w_markerMds.size(), p_context._hdfProxy);
+		for (uint32_t w_marker = 0; w_marker < w_markerCount; ++w_marker)
+		{
+			p_context._repository->createWellboreMarker(w_markerFrame, p_context._uuids->next(), "Marker " + std::to_string(w_marker));
+		}
+	}
+
+	/**
+	 * a triangulated surface made of p_patchCount patches side by side along X, each a regular triangulation of patchSize^2 nodes
+	 */
+	void generateSurface(const Context &p_context, const GeneratorOptions &p_options, uint32_t p_surfaceIndex)
+	{
+		const std::string w_name = "Horizon " + std::to_string(p_surfaceIndex);
+		RESQML2_NS::BoundaryFeature *w_horizon = p_context._repository->createHorizon(p_context._uuids->next(), w_name);
+		RESQML2_NS::HorizonInterpretation *w_interpretation = p_context._repository->createHorizonInterpretation(w_horizon, p_context._uuids->next(), w_name);
+		RESQML2_NS::TriangulatedSetRepresentation *w_surface = p_context._repository->createTriangulatedSetRepresentation(w_interpretation, p_context._uuids->next(), w_name);
+
+		const uint32_t w_patchSize = p_options._patchSize;
+		const double w_spacing = p_options._iCellCount * CELL_SIZE / (p_options._patchCount * (w_patchSize - 1));
+		const double w_depthOffset = p_surfaceIndex * 3 * LAYER_THICKNESS;
+		// the triangle node indices of a patch follow the nodes of the previous patches
+		unsigned int w_previousPatchesNodeCount = 0;
+		std::vector<double> w_nodes;
+		std::vector<unsigned int> w_triangles;
+		for (uint32_t w_patch = 0; w_patch < p_options._patchCount; ++w_patch)
+		{
+			w_nodes.clear();
+			w_triangles.clear();
+			const double w_xOrigin = w_patch * (w_patchSize - 1) * w_spacing;
+			for (uint32_t w_j = 0; w_j < w_patchSize; ++w_j)
+			{
+				for (uint32_t w_i = 0; w_i < w_patchSize; ++w_i)
+				{
+					const double w_x = w_xOrigin + w_i * w_spacing;
+					const double w_y = w_j * w_spacing;
+					w_nodes.push_back(w_x);
+					w_nodes.push_back(w_y);
+					w_nodes.push_back(getDepth(w_x, w_y) + w_depthOffset);
+				}
+			}
+			for (uint32_t w_j = 0; w_j + 1 < w_patchSize; ++w_j)
+			{
+				for (uint32_t w_i = 0; w_i + 1 < w_patchSize; ++w_i)
+				{
+					const unsigned int w_node = w_previousPatchesNodeCount + w_i + w_j * w_patchSize;
+					w_triangles.insert(w_triangles.end(), {w_node, w_node + 1, w_node + w_patchSize});
+					w_triangles.insert(w_triangles.end(), {w_node + 1, w_node + w_patchSize + 1, w_node + w_patchSize});
+				}
+			}
+			w_surface->pushBackTrianglePatch(w_patchSize * w_patchSize, w_nodes.data(), static_cast<unsigned int>(w_triangles.size() / 3), w_triangles.data(), p_context._hdfProxy);
+			w_previousPatchesNodeCount += w_patchSize * w_patchSize;
+		}
+	}
+
+	double elapsedSeconds(std::chrono::steady_clock::time_point p_start)
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - p_start).count();
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	GeneratorOptions w_options;
+	if (!parseArguments(argc, argv, w_options))
+	{
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		const auto w_start = std::chrono::steady_clock::now();
+		COMMON_NS::EpcDocument w_epcDocument(w_options._fileName);
+		COMMON_NS::DataObjectRepository w_repository;
+		COMMON_NS::AbstractObject::setFormat("F2I-CONSULTING", "FESPP", PROJECT_VERSION);
+
+		UuidGenerator w_uuids(w_options._seed);
+		Context w_context;
+		w_context._uuids = &w_uuids;
+		w_context._repository = &w_repository;
+		w_context._hdfProxy = w_repository.createHdfProxy(w_uuids.next(), "Hdf Proxy", w_epcDocument.getStorageDirectory(), w_epcDocument.getName() + ".h5", COMMON_NS::DataObjectRepository::openingMode::OVERWRITE);
+		w_context._crs = w_repository.createLocalDepth3dCrs(w_uuids.next(), "Default local CRS", .0, .0, .0, .0, gsoap_resqml2_0_1::eml20__LengthUom::m, "Unknown", gsoap_resqml2_0_1::eml20__LengthUom::m, "Unknown", false);
+		w_repository.setDefaultCrs(w_context._crs);
+		w_context._continuousPropertyKind = w_repository.createPropertyKind(w_uuids.next(), "Continous PropKind", "Fespp", gsoap_resqml2_0_1::resqml20__ResqmlUom::Euc, gsoap_resqml2_0_1::resqml20__ResqmlPropertyKind::continuous);
+		w_context._discretePropertyKind = w_repository.createPropertyKind(w_uuids.next(), "Discrete PropKind", "Fespp", gsoap_resqml2_0_1::resqml20__ResqmlUom::Euc, gsoap_resqml2_0_1::resqml20__ResqmlPropertyKind::discrete);
+
+		RESQML2_NS::IjkGridExplicitRepresentation *w_ijkGrid = generateIjkGrid(w_context, w_options);
+		generateTimeSeries(w_context, w_options, w_ijkGrid);
+		if (w_options._unstructuredSize > 0)
+		{
+			generateUnstructuredGrid(w_context, w_options);
+		}
+
+		// the wellheads are spread over the area of the IJK grid
+		const uint32_t w_wellboresPerRow = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(w_options._wellboreCount))));
+		for (uint32_t w_wellboreIndex = 0; w_wellboreIndex < w_options._wellboreCount; ++w_wellboreIndex)
+		{
+			generateWellbore(w_context, w_wellboreIndex,
+							 (w_wellboreIndex % w_wellboresPerRow + 0.5) * w_options._iCellCount * CELL_SIZE / w_wellboresPerRow,
+							 (w_wellboreIndex / w_wellboresPerRow + 0.5) * w_options._jCellCount * CELL_SIZE / w_wellboresPerRow);
+		}
+
+		for (uint32_t w_surfaceIndex = 0; w_surfaceIndex < w_options._surfaceCount; ++w_surfaceIndex)
+		{
+			generateSurface(w_context, w_options, w_surfaceIndex);
+		}
+
+		w_context._hdfProxy->close();
+		w_epcDocument.serializeFrom(w_repository);
+		w_epcDocument.close();
+
+		std::cout << "Generated " << w_options._fileName << " in " << elapsedSeconds(w_start) << " s: "
+				  << w_ijkGrid->getCellCount() << " IJK cells, "
+				  << w_options._faultCount << " faults, "
+				  << w_options._timeStepCount << " time steps, "
+				  << w_options._wellboreCount << " wellbores, "
+				  << w_options._surfaceCount << " surfaces of " << w_options._patchCount << " patches" << std::endl;
+	}
+	catch (const std::exception &e)
+	{
+		std::cerr << "fesppGenerateEpc: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -22,6 +22,7 @@ under the License.
 #include <iterator>
 #include <algorithm>
 #include <limits>
+#include <vector>
 
 #include <vtkIndent.h>
 #include <vtkInformation.h>
@@ -32,12 +33,23 @@ under the License.
 #include <vtkMultiProcessController.h>
 #include <vtkStreamingDemandDrivenPipeline.h>
 #include <vtkDataObject.h>
+#include <vtkOutputWindow.h>
 
 vtkStandardNewMacro(vtkEPCReader);
 vtkCxxSetObjectMacro(vtkEPCReader, Controller, vtkMultiProcessController);
 
 //----------------------------------------------------------------------------
 vtkEPCReader::vtkEPCReader() : Files(vtkStringArray::New()),
+                               LazyLoading(false),
+                               UseCache(false),
+                               NumberOfThreads(1),
+                               CacheSizeMB(0),
+                               NumberOfPrefetchedTimeSteps(2),
+                               HdfIdleTimeout(10),
+                               SinglePrecision(false),
+                               GhostLevels(0),
+                               Stride(1),
+                               SurfaceOnly(false),
                                Controller(nullptr),
                                AssemblyTag(0),
                                MarkerOrientation(true),
@@ -49,6 +61,15 @@ vtkEPCReader::vtkEPCReader() : Files(vtkStringArray::New()),
   SetController(vtkMultiProcessController::GetGlobalController());
 }
 
+//------------------------------------------------------------------------------
+int vtkEPCReader::RequestInformation(vtkInformation *vtkNotUsed(request),
+                                     vtkInformationVector **vtkNotUsed(inputVector), vtkInformationVector *outputVector)
+{
+  vtkInformation *outInfo = outputVector->GetInformationObject(0);
+  outInfo->Set(CAN_HANDLE_PIECE_REQUEST(), 1);
+  return 1;
+}
+
 //----------------------------------------------------------------------------
 void vtkEPCReader::AddFileNameToFiles(const char *fname)
 {
@@ -79,41 +100,147 @@ size_t vtkEPCReader::GetNumberOfFileNames() const
   return Files->GetNumberOfValues();
 }
 
+//----------------------------------------------------------------------------
+void vtkEPCReader::setLazyLoading(bool lazyLoading)
+{
+  LazyLoading = lazyLoading;
+  repository.setLazyLoading(lazyLoading);
+  Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkEPCReader::setUseCache(bool useCache)
+{
+  UseCache = useCache;
+  // only the first process writes the cache
+  repository.setUseCache(useCache, Controller == nullptr || Controller->GetLocalProcessId() == 0);
+  Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkEPCReader::setNumberOfThreads(int numberOfThreads)
+{
+  NumberOfThreads = numberOfThreads;
+  repository.setNumberOfThreads(numberOfThreads < 0 ? 1 : static_cast<uint32_t>(numberOfThreads));
+  Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkEPCReader::setCacheSizeMB(int cacheSizeMB)
+{
+  CacheSizeMB = cacheSizeMB;
+  repository.setCacheSize(cacheSizeMB < 0 ? 0 : static_cast<uint32_t>(cacheSizeMB));
+  Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkEPCReader::setNumberOfPrefetchedTimeSteps(int numberOfTimeSteps)
+{
+  NumberOfPrefetchedTimeSteps = numberOfTimeSteps;
+  repository.setNumberOfPrefetchedTimeSteps(numberOfTimeSteps < 0 ? 0 : static_cast<uint32_t>(numberOfTimeSteps));
+  Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkEPCReader::setHdfIdleTimeout(int seconds)
+{
+  HdfIdleTimeout = seconds;
+  repository.setHdfIdleTimeout(seconds < 0 ? 0 : static_cast<uint32_t>(seconds));
+  Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkEPCReader::releaseHdfFiles()
+{
+  repository.closeHdfProxies();
+}
+
+//----------------------------------------------------------------------------
+void vtkEPCReader::setSinglePrecision(bool singlePrecision)
+{
+  SinglePrecision = singlePrecision;
+  repository.setSinglePrecision(singlePrecision);
+  Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkEPCReader::setGhostLevels(int ghostLevels)
+{
+  // given to the repository with the ghost levels requested by the pipeline
+  GhostLevels = ghostLevels;
+  Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkEPCReader::setStride(int stride)
+{
+  Stride = stride;
+  repository.setStride(stride < 1 ? 1 : static_cast<uint32_t>(stride));
+  Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkEPCReader::setSurfaceOnly(bool surfaceOnly)
+{
+  SurfaceOnly = surfaceOnly;
+  repository.setSurfaceOnly(surfaceOnly);
+  Modified();
+}
+
 //------------------------------------------------------------------------------
 vtkStringArray *vtkEPCReader::GetAllFiles() // call only by GUI
 {
-  if (Files->GetNumberOfValues() > 0)
+  // all the pending files are loaded before a single pipeline update
+  std::vector<std::string> pendingFiles;
+  for (auto index = 0; index < Files->GetNumberOfValues(); index++)
+  {
+    auto file_property = Files->GetValue(index);
+    if (FileNamesLoaded.insert(file_property).second)
+    {
+      pendingFiles.push_back(file_property);
+    }
+  }
+
+  if (!pendingFiles.empty())
   {
-      for (auto index = 0; index < Files->GetNumberOfValues(); index++)
+    std::string msg = repository.addFiles(pendingFiles);
+    // add selectors waiting for their node
+    SelectPendingNodes();
+
+    if (Controller->GetLocalProcessId() == 0)
+    {
+      if (!msg.empty())
       {
-          auto file_property = Files->GetValue(index);
-          auto search = FileNamesLoaded.find(file_property);
-          if (search == FileNamesLoaded.end())
-          {
-              std::string msg = repository.addFile(file_property.c_str());
-              FileNamesLoaded.insert(file_property);
-              // add selector
-              for (auto selector : selectorNotLoaded)
-              {
-                  if (AddSelector(selector.c_str()))
-                  {
-                      selectorNotLoaded.erase(selector);
-                  }
-              }
-              
-              if (Controller->GetLocalProcessId() == 0 && !msg.empty())
-              {
-                  vtkWarningMacro(<< msg);
-              }
-              AssemblyTag++;
-              Modified();
-              Update();
-          }
+        vtkWarningMacro(<< msg);
       }
+      vtkOutputWindowDisplayText(repository.getLoadingTimes().c_str());
+    }
+    PhaseTimes = repository.getPhaseTimes();
+    AssemblyTag++;
+    Modified();
+    Update();
   }
   return Files;
 }
 
+//----------------------------------------------------------------------------
+void vtkEPCReader::SelectPendingNodes()
+{
+  for (auto it = selectorNotLoaded.begin(); it != selectorNotLoaded.end();)
+  {
+    int node_id = GetAssembly()->GetFirstNodeByPath(it->c_str());
+    if (node_id > -1)
+    {
+      repository.selectNodeId(node_id);
+      it = selectorNotLoaded.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 
 void vtkEPCReader::SetFiles(const std::string &file)
@@ -228,18 +355,7 @@ int vtkEPCReader::RequestData(vtkInformation *,
                               vtkInformationVector *outputVector)
 {
   // Load state (load selection in wait)
-  if (selectorNotLoaded.size() > 0)
-  {
-    for (auto path : selectorNotLoaded)
-    {
-      int node_id = GetAssembly()->GetFirstNodeByPath(path.c_str());
-      if (node_id > -1)
-      {
-        repository.selectNodeId(node_id);
-        selectorNotLoaded.erase(path);
-      }
-    }
-  }
+  SelectPendingNodes();
 
   auto *outInfo = outputVector->GetInformationObject(0);
   outInfo->Remove(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
@@ -261,11 +377,30 @@ int vtkEPCReader::RequestData(vtkInformation *,
     requestedTimeStep = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_TIME_STEP());
   }
 
+  // requested piece (the multi process controller is only used when the pipeline does not request any piece)
+  int piece = Controller->GetLocalProcessId();
+  int numberOfPieces = Controller->GetNumberOfProcesses();
+  if (outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES()) && outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES()) > 0)
+  {
+    piece = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_PIECE_NUMBER());
+    numberOfPieces = outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_PIECES());
+  }
+  int ghostLevels = GhostLevels < 0 ? 0 : GhostLevels;
+  if (outInfo->Has(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS()))
+  {
+    ghostLevels = (std::max)(ghostLevels, outInfo->Get(vtkStreamingDemandDrivenPipeline::UPDATE_NUMBER_OF_GHOST_LEVELS()));
+  }
+
   try
   {
-    vtkPartitionedDataSetCollection::GetData(outInfo)->DeepCopy(repository.getVtkPartitionedDatasSetCollection(requestedTimeStep, Controller->GetNumberOfProcesses(), Controller->GetLocalProcessId()));
-    // close hdfProxies in case the system would want reuse hdf files
-    repository.closeHdfProxies();
+    repository.setGhostLevels(static_cast<uint32_t>(ghostLevels));
+    ResqmlDataRepositoryToVtkPartitionedDataSetCollection::shallowCopy(repository.getVtkPartitionedDatasSetCollection(requestedTimeStep, numberOfPieces, piece),
+                                                                       vtkPartitionedDataSetCollection::GetData(outInfo));
+    LoadingStatistics = repository.getLoadingStatistics();
+    PhaseTimes = repository.getPhaseTimes();
+    // read the next time steps while the current one is rendered, then close hdfProxies once they are idle
+    // in case the system would want reuse hdf files
+    repository.startBackgroundTask(requestedTimeStep);
   }
   catch (const std::exception &e)
   {
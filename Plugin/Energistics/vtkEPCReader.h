@@ -56,6 +56,71 @@ public:
 	size_t GetNumberOfFileNames() const;
 	///@}
 
+	/**
+	 * Only deserialize the content types and relationships of the files loaded afterwards.
+	 * The data objects are deserialized when they are selected for the first time.
+	 */
+	void setLazyLoading(bool lazyLoading);
+
+	/**
+	 * Read/write the tree of the loaded files from/to a cache file of the user cache directory.
+	 */
+	void setUseCache(bool useCache);
+
+	/**
+	 * Number of threads loading the selected representations (0 means one per core).
+	 */
+	void setNumberOfThreads(int numberOfThreads);
+
+	/**
+	 * Memory budget (in MB) of the deselected representations kept for a later selection.
+	 */
+	void setCacheSizeMB(int cacheSizeMB);
+
+	/**
+	 * Number of time steps following the displayed one whose properties are read in background.
+	 */
+	void setNumberOfPrefetchedTimeSteps(int numberOfTimeSteps);
+
+	/**
+	 * Number of seconds after which the unused HDF5 files are closed (0 closes them after each update).
+	 */
+	void setHdfIdleTimeout(int seconds);
+
+	/**
+	 * Close the HDF5 files now, e.g. to let another tool write them.
+	 */
+	void releaseHdfFiles();
+
+	/**
+	 * Store the geometry as float relative to a local origin of each dataset, and the continuous properties as float.
+	 */
+	void setSinglePrecision(bool singlePrecision);
+
+	/**
+	 * Number of ghost cell layers around the block of a distributed IJK grid loaded by each process.
+	 */
+	void setGhostLevels(int ghostLevels);
+
+	/**
+	 * Load the IJK grids as a coarsened preview made of a cell every stride cells along each axis (1 for the full resolution).
+	 */
+	void setStride(int stride);
+
+	/**
+	 * Load only the boundary faces of the IJK grids as vtkPolyData.
+	 */
+	void setSurfaceOnly(bool surfaceOnly);
+
+	/**
+	 * Loading time, bytes read, values converted and peak memory of all the loaded objects (total then each object).
+	 */
+	const char *GetLoadingStatistics() const { return LoadingStatistics.c_str(); }
+	/**
+	 * Duration (ms) of each phase of the last file loading and of the last update, as a JSON object.
+	 */
+	const char *GetPhaseTimes() const { return PhaseTimes.c_str(); }
+
 
 	// --------------- PART: Multi-Processor -------------
 
@@ -139,13 +204,31 @@ protected:
 	~vtkEPCReader() final { SetController(nullptr); }
 
 private:
+	int RequestInformation(vtkInformation *, vtkInformationVector **, vtkInformationVector *) final;
 	int RequestData(vtkInformation *, vtkInformationVector **, vtkInformationVector *) final;
 
+	/**
+	 * select the nodes of the selectors set before their file has been loaded
+	 */
+	void SelectPendingNodes();
+
 	// files
 	vtkSmartPointer<vtkStringArray> Files;
 	char* FileName;
 	std::set<std::string> FilesList;
 	std::set<std::string> FileNamesLoaded;
+	bool LazyLoading;
+	bool UseCache;
+	int NumberOfThreads;
+	int CacheSizeMB;
+	int NumberOfPrefetchedTimeSteps;
+	int HdfIdleTimeout;
+	bool SinglePrecision;
+	int GhostLevels;
+	int Stride;
+	bool SurfaceOnly;
+	std::string LoadingStatistics;
+	std::string PhaseTimes;
 
 	std::set<std::string> selectorNotLoaded; // load state, load selector before files :(
 
@@ -251,12 +251,36 @@ RESQML2_NS::UnstructuredGridRepresentation* vtkEPCWriter::writeUnstructuredGrid(
 
 	uint64_t numberOfCells = Internal->inputUnstructuredGrid->GetNumberOfCells();
 
+	// Large (e.g. synthetic) grids: reserve the face arrays from the cell types instead of growing them cell after cell.
+	// The faces of the polyhedra are not counted: they are appended as they come.
+	uint64_t faceCount = 0;
+	uint64_t faceNodeCount = 0;
 	for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
 	{
+		switch (Internal->inputUnstructuredGrid->GetCellType(cellId))
+		{
+		case VTK_TETRA: faceCount += 4; faceNodeCount += 12; break;
+		case VTK_HEXAHEDRON: faceCount += 6; faceNodeCount += 24; break;
+		case VTK_WEDGE: faceCount += 5; faceNodeCount += 18; break;
+		case VTK_PYRAMID: faceCount += 5; faceNodeCount += 16; break;
+		case VTK_PENTAGONAL_PRISM: faceCount += 7; faceNodeCount += 30; break;
+		case VTK_HEXAGONAL_PRISM: faceCount += 8; faceNodeCount += 36; break;
+		default: break;
+		}
+	}
+	w_nodeIndicesPerFace.reserve(faceNodeCount);
+	w_nodeIndicesCumulativeCountPerFace.reserve(faceCount);
+	faceIndicesPerCell.reserve(faceCount);
+	faceIndicesCumulativeCountPerCell.reserve(numberOfCells);
+	faceRightHandness.reserve(faceCount);
 
-		vtkCell* const cell = Internal->inputUnstructuredGrid->GetCell(cellId);
-		int32_t const cellType = cell->GetCellType();
-		vtkIdType const* const ptsIds = cell->GetPointIds()->begin();
+	for (vtkIdType cellId = 0; cellId < numberOfCells; ++cellId)
+	{
+		// read the cell connectivity in place instead of instantiating a vtkCell per cell
+		int32_t const cellType = Internal->inputUnstructuredGrid->GetCellType(cellId);
+		vtkIdType numberOfCellPoints;
+		vtkIdType const* ptsIds;
+		Internal->inputUnstructuredGrid->GetCellPoints(cellId, numberOfCellPoints, ptsIds);
 		if (cellType == VTK_TETRA)
 		{
 			loadFacesForVTK_TETRA(ptsIds, w_nodeIndicesPerFace, w_nodeIndicesCumulativeCountPerFace, faceIndicesPerCell, faceIndicesCumulativeCountPerCell, faceRightHandness);
@@ -308,15 +332,11 @@ std::vector<double> vtkEPCWriter::getUnstructuredGridPoints()
 {
 	vtkSmartPointer<vtkPoints> w_points = Internal->inputUnstructuredGrid->GetPoints();
 	vtkIdType numberPoints = w_points->GetNumberOfPoints();
-	std::vector<double> unstructuredGridPoints;
+	std::vector<double> unstructuredGridPoints(numberPoints * 3);
 
 	for (vtkIdType i = 0; i < numberPoints; ++i)
 	{
-		double p[3];
-		w_points->GetPoint(i, p);
-		unstructuredGridPoints.push_back(p[0]);
-		unstructuredGridPoints.push_back(p[1]);
-		unstructuredGridPoints.push_back(p[2]);
+		w_points->GetPoint(i, unstructuredGridPoints.data() + i * 3);
 	}
 	return unstructuredGridPoints;
 }
@@ -824,7 +844,6 @@ void vtkEPCWriter::loadFacesForVTK_POLYHEDRON(vtkIdType cellId, std::vector<uint
 	uint64_t initFaceId = faceIndicesPerCell.empty() ? 0 : faceIndicesPerCell.back() + 1;
 	uint64_t initFaceIndicesCumulative = faceIndicesCumulativeCountPerCell.empty() ? 0 : faceIndicesCumulativeCountPerCell.back();
 	faceIndicesCumulativeCountPerCell.push_back(initFaceIndicesCumulative + nfaces);
-	faceIndicesPerCell.reserve(nfaces);
 	for (vtkIdType id = 0; id < nfaces; ++id)
 	{
 		faceIndicesPerCell.push_back(initFaceId + id);
@@ -832,7 +851,6 @@ void vtkEPCWriter::loadFacesForVTK_POLYHEDRON(vtkIdType cellId, std::vector<uint
 		newNodeIndicesCumulativeCountPerFace += nbPoints;
 		nodeIndicesCumulativeCountPerFace.push_back(newNodeIndicesCumulativeCountPerFace);
 		faceRightHandness.push_back(1);
-		p_nodeIndicesPerFace.reserve(nbPoints);
 		for (vtkIdType j = 1; j <= nbPoints; ++j)
 		{
 			double ptsIds = facePtIds[j];
@@ -260,7 +260,8 @@ int vtkETPSource::RequestData(vtkInformation *,
 
   try
   {
-    vtkPartitionedDataSetCollection::GetData(outInfo)->DeepCopy(this->repository.getVtkPartitionedDatasSetCollection(requestedTimeStep));
+    ResqmlDataRepositoryToVtkPartitionedDataSetCollection::shallowCopy(this->repository.getVtkPartitionedDatasSetCollection(requestedTimeStep),
+                                                                       vtkPartitionedDataSetCollection::GetData(outInfo));
   }
   catch (const std::exception &e)
   {